@@ -35,6 +35,8 @@ declare global {
     var network: Network;
     /** APIs for the park and management of it. */
     var park: Park;
+    /** APIs for timing the game logic update. */
+    var profiler: Profiler;
     /** APIs for the current scenario. */
     var scenario: Scenario;
     /**
@@ -134,6 +136,45 @@ declare global {
         executeLegacy(command: string): void;
     }
 
+    /**
+     * Times each stage of the game logic update. Timings are kept for the most recent
+     * 1024 ticks and are given in microseconds.
+     */
+    interface Profiler {
+        /**
+         * Whether the profiler is currently recording.
+         */
+        readonly enabled: boolean;
+
+        /**
+         * The number of ticks recorded since the profiler was last reset.
+         */
+        readonly ticks: number;
+
+        start(): void;
+        stop(): void;
+        reset(): void;
+
+        /**
+         * Gets the timings of each stage, the last stage is the total for the tick.
+         */
+        getData(): ProfilerStage[];
+
+        /**
+         * Gets the number of entities in each entity list at the end of the last recorded tick.
+         */
+        getEntityCounts(): { [list: string]: number };
+    }
+
+    interface ProfilerStage {
+        name: string;
+        samples: number;
+        mean: number;
+        p50: number;
+        p99: number;
+        max: number;
+    }
+
     /**
      * Core APIs for storage and subscriptions.
      */
@@ -161,6 +161,7 @@ namespace OpenRCT2
             //       If objects use GetContext() in their destructor things won't go well.
 
             GameActions::ClearQueue();
+            scenario_wait_for_pending_save();
             network_close();
             window_close_all();
 
@@ -950,7 +951,16 @@ namespace OpenRCT2
 
             if (_accumulator < GAME_UPDATE_TIME_MS)
             {
-                platform_sleep(GAME_UPDATE_TIME_MS - _accumulator - 1);
+                const auto timeout = GAME_UPDATE_TIME_MS - _accumulator - 1;
+                if (gOpenRCT2Headless)
+                {
+                    // Dedicated servers wake up early to service clients sending data.
+                    network_wait_for_data(timeout);
+                }
+                else
+                {
+                    platform_sleep(timeout);
+                }
                 return;
             }
 
@@ -16,6 +16,7 @@
 #include "Input.h"
 #include "OpenRCT2.h"
 #include "ReplayManager.h"
+#include "TickProfiler.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
 #include "interface/Screenshot.h"
@@ -227,6 +228,10 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    // The timer only starts once it is known that this tick runs, the network update before that still counts towards
+    // the network stage.
+    const auto tickStart = TickProfiler::Now();
+
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
@@ -268,6 +273,8 @@ void GameState::UpdateLogic()
             }
         }
     }
+    TickProfiler::TickTimer tickTimer(tickStart);
+    tickTimer.Lap(TickStage::Network);
 
 #ifdef ENABLE_SCRIPTING
     // Stash the current day number before updating the date so that we
@@ -277,34 +284,51 @@ void GameState::UpdateLogic()
 
     date_update();
     _date = Date(static_cast<uint32_t>(gDateMonthsElapsed), gDateMonthTicks);
+    tickTimer.Lap(TickStage::Date);
 
     scenario_update();
+    tickTimer.Lap(TickStage::Scenario);
     climate_update();
+    tickTimer.Lap(TickStage::Climate);
     map_update_tiles();
+    tickTimer.Lap(TickStage::MapTiles);
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
     map_update_path_wide_flags();
+    tickTimer.Lap(TickStage::MapPaths);
     peep_update_all();
     map_restore_provisional_elements();
+    tickTimer.Lap(TickStage::Peeps);
     vehicle_update_all();
+    tickTimer.Lap(TickStage::Vehicles);
     sprite_misc_update_all();
+    tickTimer.Lap(TickStage::MiscEntities);
     Ride::UpdateAll();
+    tickTimer.Lap(TickStage::Rides);
 
     if (!(gScreenFlags & SCREEN_FLAGS_EDITOR))
     {
         _park->Update(_date);
     }
+    tickTimer.Lap(TickStage::Park);
 
     research_update();
+    tickTimer.Lap(TickStage::Research);
     ride_ratings_update_all();
+    tickTimer.Lap(TickStage::RideRatings);
     ride_measurements_update();
+    tickTimer.Lap(TickStage::RideMeasurements);
     News::UpdateCurrentItem();
+    tickTimer.Lap(TickStage::News);
 
     map_animation_invalidate_all();
+    tickTimer.Lap(TickStage::MapAnimations);
     vehicle_sounds_update();
     peep_update_crowd_noise();
     climate_update_sound();
+    tickTimer.Lap(TickStage::Sounds);
     editor_open_windows_for_current_step();
+    tickTimer.Lap(TickStage::EditorWindows);
 
     // Update windows
     // window_dispatch_update_all();
@@ -316,9 +340,11 @@ void GameState::UpdateLogic()
     }
 
     GameActions::ProcessQueue();
+    tickTimer.Lap(TickStage::GameActions);
 
     network_process_pending();
     network_flush();
+    tickTimer.Lap(TickStage::NetworkFlush);
 
     gCurrentTicks++;
     gScenarioTicks++;
@@ -332,6 +358,7 @@ void GameState::UpdateLogic()
     {
         hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
     }
+    tickTimer.Lap(TickStage::Scripting);
 #endif
 }
 
@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TickProfiler.h"
+
+#include "core/CircularBuffer.h"
+#include "world/Sprite.h"
+
+#include <algorithm>
+#include <array>
+
+namespace TickProfiler
+{
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(TickStage::Count);
+
+    // clang-format off
+    static constexpr const char* StageNames[STAGE_COUNT] = {
+        "network", "date", "scenario", "climate", "map_tiles", "map_paths", "peeps", "vehicles", "misc_entities", "rides",
+        "park", "research", "ride_ratings", "ride_measurements", "news", "map_animations", "sounds", "editor_windows",
+        "game_actions", "network_flush", "scripting", "total",
+    };
+
+    static constexpr const char* EntityListNames[] = {
+        "trains", "peeps", "misc", "litter", "vehicles",
+    };
+    // clang-format on
+    static_assert(std::size(EntityListNames) == static_cast<size_t>(EntityListId::Count) - 1);
+
+    struct StageSamples
+    {
+        // Nanoseconds, clamped to 32 bits which is over four seconds.
+        CircularBuffer<uint32_t, SAMPLE_WINDOW> Window;
+        uint64_t Samples{};
+        uint64_t Current{};
+        uint64_t Last{};
+    };
+
+    static bool _enabled;
+    static uint64_t _tickCount;
+    static std::array<StageSamples, STAGE_COUNT> _stages;
+    static std::array<uint32_t, std::size(EntityListNames)> _entityCounts;
+
+    bool IsEnabled()
+    {
+        return _enabled;
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        _enabled = enabled;
+    }
+
+    void Reset()
+    {
+        for (auto& stage : _stages)
+        {
+            stage = {};
+        }
+        _entityCounts = {};
+        _tickCount = 0;
+    }
+
+    void Record(TickStage stage, std::chrono::steady_clock::duration elapsed)
+    {
+        auto nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        auto& samples = _stages[static_cast<size_t>(stage)];
+        samples.Window.push_back(static_cast<uint32_t>(std::min<uint64_t>(nanoseconds, UINT32_MAX)));
+        samples.Samples++;
+        samples.Current += nanoseconds;
+    }
+
+    void EndTick(std::chrono::steady_clock::duration elapsed)
+    {
+        Record(TickStage::Total, elapsed);
+        for (auto& stage : _stages)
+        {
+            stage.Last = stage.Current;
+            stage.Current = 0;
+        }
+
+        // The free list is skipped, EntityListNames starts at the train list.
+        for (size_t i = 0; i < _entityCounts.size(); i++)
+        {
+            _entityCounts[i] = gSpriteListCount[i + static_cast<size_t>(EntityListId::TrainHead)];
+        }
+        _tickCount++;
+    }
+
+    const char* GetStageName(TickStage stage)
+    {
+        return StageNames[static_cast<size_t>(stage)];
+    }
+
+    uint64_t GetTickCount()
+    {
+        return _tickCount;
+    }
+
+    std::vector<StageStats> GetStageStats()
+    {
+        std::vector<StageStats> result;
+        std::vector<uint32_t> sorted;
+        for (size_t i = 0; i < STAGE_COUNT; i++)
+        {
+            const auto& samples = _stages[i];
+            StageStats stats{};
+            stats.Name = StageNames[i];
+            stats.Samples = samples.Samples;
+
+            sorted.resize(samples.Window.size());
+            for (size_t j = 0; j < sorted.size(); j++)
+            {
+                sorted[j] = samples.Window[j];
+            }
+            if (!sorted.empty())
+            {
+                std::sort(sorted.begin(), sorted.end());
+                uint64_t sum = 0;
+                for (auto sample : sorted)
+                {
+                    sum += sample;
+                }
+                stats.Mean = sum / 1000.0 / sorted.size();
+                stats.P50 = sorted[sorted.size() / 2] / 1000.0;
+                stats.P99 = sorted[(sorted.size() * 99) / 100] / 1000.0;
+                stats.Max = sorted.back() / 1000.0;
+            }
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    std::vector<EntityCount> GetEntityCounts()
+    {
+        std::vector<EntityCount> result;
+        for (size_t i = 0; i < _entityCounts.size(); i++)
+        {
+            result.push_back({ EntityListNames[i], _entityCounts[i] });
+        }
+        return result;
+    }
+
+    std::vector<double> GetLastTick()
+    {
+        std::vector<double> result;
+        for (const auto& stage : _stages)
+        {
+            result.push_back(stage.Last / 1000.0);
+        }
+        return result;
+    }
+} // namespace TickProfiler
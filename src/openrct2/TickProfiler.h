@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * The stages of GameState::UpdateLogic that are timed individually.
+ */
+enum class TickStage : uint8_t
+{
+    Network,
+    Date,
+    Scenario,
+    Climate,
+    MapTiles,
+    MapPaths,
+    Peeps,
+    Vehicles,
+    MiscEntities,
+    Rides,
+    Park,
+    Research,
+    RideRatings,
+    RideMeasurements,
+    News,
+    MapAnimations,
+    Sounds,
+    EditorWindows,
+    GameActions,
+    NetworkFlush,
+    Scripting,
+    Total,
+    Count,
+};
+
+namespace TickProfiler
+{
+    // Number of most recent ticks the percentiles are calculated over.
+    constexpr size_t SAMPLE_WINDOW = 1024;
+
+    struct StageStats
+    {
+        const char* Name;
+        uint64_t Samples;
+        // Timings in microseconds over the sample window.
+        double Mean;
+        double P50;
+        double P99;
+        double Max;
+    };
+
+    struct EntityCount
+    {
+        const char* Name;
+        uint32_t Count;
+    };
+
+    bool IsEnabled();
+    void SetEnabled(bool enabled);
+    void Reset();
+
+    void Record(TickStage stage, std::chrono::steady_clock::duration elapsed);
+    void EndTick(std::chrono::steady_clock::duration elapsed);
+
+    const char* GetStageName(TickStage stage);
+    uint64_t GetTickCount();
+    std::vector<StageStats> GetStageStats();
+    std::vector<EntityCount> GetEntityCounts();
+
+    /**
+     * Timings of the most recently completed tick in microseconds, indexed by TickStage.
+     */
+    std::vector<double> GetLastTick();
+
+    /**
+     * The current time if profiling is enabled, otherwise a default constructed time point.
+     */
+    inline std::chrono::steady_clock::time_point Now()
+    {
+        return IsEnabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    }
+
+    /**
+     * Times consecutive stages of a single tick. Each call to Lap attributes the time since the previous lap to the
+     * given stage, the total is recorded when the timer goes out of scope.
+     */
+    class TickTimer
+    {
+    private:
+        bool _enabled;
+        std::chrono::steady_clock::time_point _start;
+        std::chrono::steady_clock::time_point _lap;
+
+    public:
+        /**
+         * @param start When the tick started, as returned by Now. Lets work that has to happen before it is known
+         * whether the tick runs at all be attributed to the first stage.
+         */
+        explicit TickTimer(std::chrono::steady_clock::time_point start)
+            : _enabled(IsEnabled())
+        {
+            if (_enabled)
+            {
+                _start = start == std::chrono::steady_clock::time_point{} ? std::chrono::steady_clock::now() : start;
+                _lap = _start;
+            }
+        }
+
+        TickTimer(const TickTimer&) = delete;
+
+        ~TickTimer()
+        {
+            if (_enabled)
+            {
+                EndTick(std::chrono::steady_clock::now() - _start);
+            }
+        }
+
+        void Lap(TickStage stage)
+        {
+            if (_enabled)
+            {
+                auto now = std::chrono::steady_clock::now();
+                Record(stage, now - _lap);
+                _lap = now;
+            }
+        }
+    };
+} // namespace TickProfiler
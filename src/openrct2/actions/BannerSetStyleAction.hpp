@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Banner.h"
@@ -152,6 +153,7 @@ public:
                     allowedEdges &= ~(1 << bannerElement->GetPosition());
                 }
                 bannerElement->SetAllowedEdges(allowedEdges);
+                footpath_graph_invalidate();
                 break;
             }
             default:
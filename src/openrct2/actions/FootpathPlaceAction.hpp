@@ -15,6 +15,8 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
+#include "../world/AmenityMap.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -193,6 +195,7 @@ private:
         pathElement->SetSurfaceEntryIndex(_type & ~FOOTPATH_ELEMENT_INSERT_QUEUE);
         bool isQueue = _type & FOOTPATH_ELEMENT_INSERT_QUEUE;
         pathElement->SetIsQueue(isQueue);
+        footpath_graph_invalidate();
 
         rct_scenery_entry* elem = pathElement->GetAdditionEntry();
         if (elem != nullptr)
@@ -216,6 +219,7 @@ private:
                     pathElement->SetAddition(0);
                 }
             }
+            amenity_map_invalidate_tile(_loc);
         }
 
         RemoveIntersectingWalls(pathElement);
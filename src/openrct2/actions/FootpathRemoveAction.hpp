@@ -15,6 +15,7 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../world/AmenityMap.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -103,6 +104,7 @@ public:
             }
             footpath_remove_edges_at(_loc, footpathElement);
             map_invalidate_tile_full(_loc);
+            amenity_map_invalidate_tile(_loc);
             tile_element_remove(footpathElement);
             footpath_update_queue_chains();
 
@@ -15,6 +15,7 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../world/AmenityMap.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -198,6 +199,7 @@ public:
 
         pathElement->SetAddition(_pathItemType);
         pathElement->SetIsBroken(false);
+        amenity_map_invalidate_tile(_loc);
         if (_pathItemType != 0)
         {
             rct_scenery_entry* scenery_entry = get_footpath_item_entry(_pathItemType - 1);
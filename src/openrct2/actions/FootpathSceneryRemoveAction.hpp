@@ -15,6 +15,7 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../world/AmenityMap.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -116,6 +117,7 @@ public:
 
         pathElement->SetAddition(0);
         map_invalidate_tile_full(_loc);
+        amenity_map_invalidate_tile(_loc);
 
         auto res = MakeResult();
         res->Position = _loc;
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../ReplayManager.h"
+#include "../TickProfiler.h"
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
@@ -27,6 +28,8 @@
 #include "../world/Scenery.h"
 
 #include <algorithm>
+#include <chrono>
+#include <deque>
 #include <iterator>
 
 using namespace OpenRCT2;
@@ -87,11 +90,13 @@ namespace GameActions
         uint32_t tick;
         uint32_t uniqueId;
         GameAction::Ptr action;
+        std::chrono::steady_clock::time_point queuedAt;
 
         explicit QueuedGameAction(uint32_t t, std::unique_ptr<GameAction>&& ga, uint32_t id)
             : tick(t)
             , uniqueId(id)
             , action(std::move(ga))
+            , queuedAt(std::chrono::steady_clock::now())
         {
         }
 
@@ -108,10 +113,24 @@ namespace GameActions
         }
     };
 
+    struct QueueTimings
+    {
+        const char* Name;
+        uint64_t Count;
+        // Nanoseconds
+        uint64_t TotalWait;
+        uint64_t MaxWait;
+        uint64_t TotalExecute;
+        uint64_t MaxExecute;
+    };
+
     static GameActionFactory _actions[GAME_COMMAND_COUNT];
-    static std::multiset<QueuedGameAction> _actionQueue;
+    // Kept sorted by tick and unique id, actions nearly always arrive in that order so they are appended.
+    static std::deque<QueuedGameAction> _actionQueue;
     static uint32_t _nextUniqueId = 0;
     static bool _suspended = false;
+    static QueueTimings _queueTimings[GAME_COMMAND_COUNT];
+    static size_t _queuePeakDepth;
 
     GameActionFactory Register(uint32_t id, GameActionFactory factory)
     {
@@ -141,6 +160,15 @@ namespace GameActions
         _suspended = false;
     }
 
+    static const char* GetRealm()
+    {
+        if (network_get_mode() == NETWORK_MODE_CLIENT)
+            return "cl";
+        else if (network_get_mode() == NETWORK_MODE_SERVER)
+            return "sv";
+        return "sp";
+    }
+
     void Enqueue(const GameAction* ga, uint32_t tick)
     {
         auto action = Clone(ga);
@@ -155,7 +183,75 @@ namespace GameActions
             // as that normally happens when receiving them over network.
             ga->SetPlayer(network_get_current_player_id());
         }
-        _actionQueue.emplace(tick, std::move(ga), _nextUniqueId++);
+        QueuedGameAction queued(tick, std::move(ga), _nextUniqueId++);
+        if (_actionQueue.empty() || !(queued < _actionQueue.back()))
+        {
+            _actionQueue.push_back(std::move(queued));
+        }
+        else
+        {
+            auto it = std::upper_bound(_actionQueue.begin(), _actionQueue.end(), queued);
+            _actionQueue.insert(it, std::move(queued));
+        }
+        _queuePeakDepth = std::max(_queuePeakDepth, _actionQueue.size());
+    }
+
+    static uint64_t ToNanoseconds(std::chrono::steady_clock::duration duration)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    static void RecordQueueTimings(
+        const GameAction* action, std::chrono::steady_clock::duration wait, std::chrono::steady_clock::duration execute)
+    {
+        auto waitNs = ToNanoseconds(wait);
+        auto executeNs = ToNanoseconds(execute);
+        log_verbose(
+            "[%s] GA: %s waited %.3f ms, executed in %.3f ms", GetRealm(), action->GetName(), waitNs / 1000000.0,
+            executeNs / 1000000.0);
+
+        auto type = action->GetType();
+        if (!TickProfiler::IsEnabled() || type >= std::size(_queueTimings))
+            return;
+
+        auto& timings = _queueTimings[type];
+        timings.Name = action->GetName();
+        timings.Count++;
+        timings.TotalWait += waitNs;
+        timings.MaxWait = std::max(timings.MaxWait, waitNs);
+        timings.TotalExecute += executeNs;
+        timings.MaxExecute = std::max(timings.MaxExecute, executeNs);
+    }
+
+    std::vector<QueueStats> GetQueueStats()
+    {
+        std::vector<QueueStats> result;
+        for (const auto& timings : _queueTimings)
+        {
+            if (timings.Count == 0)
+                continue;
+
+            QueueStats stats{};
+            stats.Name = timings.Name;
+            stats.Count = timings.Count;
+            stats.MeanWait = timings.TotalWait / 1000.0 / timings.Count;
+            stats.MaxWait = timings.MaxWait / 1000.0;
+            stats.MeanExecute = timings.TotalExecute / 1000.0 / timings.Count;
+            stats.MaxExecute = timings.MaxExecute / 1000.0;
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    size_t GetQueuePeakDepth()
+    {
+        return _queuePeakDepth;
+    }
+
+    void ResetQueueStats()
+    {
+        std::fill(std::begin(_queueTimings), std::end(_queueTimings), QueueTimings{});
+        _queuePeakDepth = _actionQueue.size();
     }
 
     void ProcessQueue()
@@ -168,14 +264,13 @@ namespace GameActions
 
         const uint32_t currentTick = gCurrentTicks;
 
-        while (_actionQueue.begin() != _actionQueue.end())
+        while (!_actionQueue.empty())
         {
             // run all the game commands at the current tick
-            const QueuedGameAction& queued = *_actionQueue.begin();
-
             if (network_get_mode() == NETWORK_MODE_CLIENT)
             {
-                if (queued.tick < currentTick)
+                const QueuedGameAction& front = _actionQueue.front();
+                if (front.tick < currentTick)
                 {
                     // This should never happen.
                     Guard::Assert(
@@ -183,14 +278,18 @@ namespace GameActions
                         "Discarding game action %s (%u) from tick behind current tick, ID: %08X, Action Tick: %08X, Current "
                         "Tick: "
                         "%08X\n",
-                        queued.action->GetName(), queued.action->GetType(), queued.uniqueId, queued.tick, currentTick);
+                        front.action->GetName(), front.action->GetType(), front.uniqueId, front.tick, currentTick);
                 }
-                else if (queued.tick > currentTick)
+                else if (front.tick > currentTick)
                 {
                     return;
                 }
             }
 
+            // Take the action out first, executing it may enqueue further actions.
+            QueuedGameAction queued = std::move(_actionQueue.front());
+            _actionQueue.pop_front();
+
             // Remove ghost scenery so it doesn't interfere with incoming network command
             switch (queued.action->GetType())
             {
@@ -207,14 +306,15 @@ namespace GameActions
 
             Guard::Assert(action != nullptr);
 
+            auto executeStart = std::chrono::steady_clock::now();
             GameActionResult::Ptr result = Execute(action);
+            RecordQueueTimings(action, executeStart - queued.queuedAt, std::chrono::steady_clock::now() - executeStart);
+
             if (result->Error == GA_ERROR::OK && network_get_mode() == NETWORK_MODE_SERVER)
             {
                 // Relay this action to all other clients.
                 network_send_game_action(action);
             }
-
-            _actionQueue.erase(_actionQueue.begin());
         }
     }
 
@@ -324,15 +424,6 @@ namespace GameActions
         return QueryInternal(action, false);
     }
 
-    static const char* GetRealm()
-    {
-        if (network_get_mode() == NETWORK_MODE_CLIENT)
-            return "cl";
-        else if (network_get_mode() == NETWORK_MODE_SERVER)
-            return "sv";
-        return "sp";
-    }
-
     struct ActionLogContext_t
     {
         MemoryStream output;
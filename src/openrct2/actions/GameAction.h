@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 /**
  * Common error codes for game actions.
@@ -391,6 +392,22 @@ namespace GameActions
     void ProcessQueue();
     void ClearQueue();
 
+    struct QueueStats
+    {
+        const char* Name;
+        uint64_t Count;
+        // Microseconds from being queued until execution starts, and of the execution itself.
+        double MeanWait;
+        double MaxWait;
+        double MeanExecute;
+        double MaxExecute;
+    };
+
+    // Timings of queued actions per action type, only collected while the tick profiler is enabled.
+    std::vector<QueueStats> GetQueueStats();
+    size_t GetQueuePeakDepth();
+    void ResetQueueStats();
+
     GameAction::Ptr Create(uint32_t id);
     GameAction::Ptr Clone(const GameAction* action);
 
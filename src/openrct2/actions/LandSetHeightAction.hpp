@@ -17,6 +17,7 @@
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
 #include "../windows/Intent.h"
+#include "../world/AmenityMap.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
@@ -275,6 +276,7 @@ private:
                 continue;
             if (_height + 4 < tileElement->base_height)
                 continue;
+            amenity_map_invalidate_tile(_coords);
             tile_element_remove(tileElement--);
         } while (!(tileElement++)->IsLastForTile());
     }
@@ -18,6 +18,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../ride/Ride.h"
+#include "../world/AmenityMap.h"
 #include "../world/Park.h"
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
@@ -196,6 +197,7 @@ public:
                         continue;
 
                     map_invalidate_tile_full(currentTile);
+                    amenity_map_invalidate_tile(currentTile);
                     tile_element_remove(sceneryElement);
 
                     element_found = true;
@@ -23,6 +23,7 @@
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/AmenityMap.h"
 #include "../world/Banner.h"
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
@@ -422,6 +423,8 @@ private:
             it.element->AsPath()->SetIsBroken(false);
         } while (tile_element_iterator_next(&it));
 
+        amenity_map_invalidate_all();
+
         gfx_invalidate_screen();
     }
 
@@ -18,6 +18,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../ride/Ride.h"
+#include "../world/AmenityMap.h"
 #include "../world/Park.h"
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
@@ -134,6 +135,7 @@ public:
         res->Position.z = tile_element_height(res->Position);
 
         map_invalidate_tile_full(_loc);
+        amenity_map_invalidate_tile(_loc);
         tile_element_remove(tileElement);
 
         return res;
@@ -15,6 +15,7 @@
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
 #include "../util/Util.h"
+#include "../world/AmenityMap.h"
 #include "../world/MapAnimation.h"
 #include "../world/Surface.h"
 #include "GameAction.h"
@@ -263,6 +264,7 @@ public:
                 if (footpathElement != nullptr && footpathElement->AsPath()->HasAddition())
                 {
                     footpathElement->AsPath()->SetAddition(0);
+                    amenity_map_invalidate_tile(mapLoc);
                 }
             }
 
@@ -7,13 +7,23 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../drawing/Drawing.h"
 #include "../interface/Screenshot.h"
+#include "../util/Util.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchGfxKernels(CommandLineArgEnumerator* argEnumerator);
 
 const CommandLineCommand CommandLine::BenchGfxCommands[]{
     // Main commands
+    DefineCommand("kernels", "[iterations count]", nullptr, HandleBenchGfxKernels),
     DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx), CommandTableEnd
 };
 
@@ -28,3 +38,106 @@ static exitcode_t HandleBenchGfx(CommandLineArgEnumerator* argEnumerator)
     }
     return EXITCODE_OK;
 }
+
+static void BlitRuns(
+    BlitRunFunc blitRun, const std::vector<int32_t>& runLengths, const uint8_t* src, uint8_t* dst, const PaletteMap& paletteMap)
+{
+    size_t offset = 0;
+    for (auto length : runLengths)
+    {
+        blitRun(src + offset, dst + offset, length, paletteMap);
+        offset += length;
+    }
+}
+
+/**
+ * Checks every vectorised run blitter the CPU supports against the scalar one and prints their throughput.
+ */
+static exitcode_t HandleBenchGfxKernels(CommandLineArgEnumerator* argEnumerator)
+{
+    int32_t iterationCount = 100;
+    argEnumerator->TryPopInteger(&iterationCount);
+
+    // Runs as found in RLE sprites, up to 127 pixels long with some zero pixels and palette entries in between.
+    constexpr size_t PIXEL_COUNT = 1024 * 1024;
+    std::mt19937 random(1);
+    std::vector<uint8_t> source(PIXEL_COUNT);
+    std::vector<uint8_t> destination(PIXEL_COUNT);
+    std::vector<int32_t> runLengths;
+    for (size_t i = 0; i < PIXEL_COUNT; i++)
+    {
+        source[i] = (random() % 16 == 0) ? 0 : static_cast<uint8_t>(random());
+        destination[i] = static_cast<uint8_t>(random());
+    }
+    for (size_t remaining = PIXEL_COUNT; remaining > 0;)
+    {
+        auto length = std::min<size_t>(remaining, 1 + random() % 127);
+        runLengths.push_back(static_cast<int32_t>(length));
+        remaining -= length;
+    }
+
+    uint8_t remapData[256];
+    std::vector<uint8_t> blendData(255 * 256);
+    for (auto& entry : remapData)
+    {
+        entry = (random() % 32 == 0) ? 0 : static_cast<uint8_t>(random());
+    }
+    for (auto& entry : blendData)
+    {
+        entry = (random() % 32 == 0) ? 0 : static_cast<uint8_t>(random());
+    }
+    auto remapMap = PaletteMap(remapData);
+    auto blendMap = PaletteMap(blendData.data(), 255, 256);
+
+    struct Kernel
+    {
+        const char* Name;
+        BlitRunFunc BlitRunFunctions::*Function;
+        const PaletteMap& Map;
+    };
+    const Kernel kernels[] = {
+        { "copy", &BlitRunFunctions::Copy, remapMap },
+        { "remap", &BlitRunFunctions::Remap, remapMap },
+        { "filter", &BlitRunFunctions::Filter, remapMap },
+        { "blend", &BlitRunFunctions::Blend, blendMap },
+    };
+
+    std::vector<const BlitRunFunctions*> implementations = { &blit_run_scalar };
+    if (sse41_available())
+    {
+        implementations.push_back(&blit_run_sse4_1);
+    }
+    if (avx2_available())
+    {
+        implementations.push_back(&blit_run_avx2);
+    }
+
+    bool allExact = true;
+    for (const auto& kernel : kernels)
+    {
+        auto expected = destination;
+        BlitRuns(blit_run_scalar.*kernel.Function, runLengths, source.data(), expected.data(), kernel.Map);
+
+        for (auto implementation : implementations)
+        {
+            auto blitRun = implementation->*kernel.Function;
+            auto actual = destination;
+            BlitRuns(blitRun, runLengths, source.data(), actual.data(), kernel.Map);
+            bool exact = actual == expected;
+            allExact &= exact;
+
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            for (int32_t i = 0; i < iterationCount; i++)
+            {
+                BlitRuns(blitRun, runLengths, source.data(), actual.data(), kernel.Map);
+            }
+            const auto endTime = std::chrono::high_resolution_clock::now();
+            auto seconds = std::chrono::duration<double>(endTime - startTime).count();
+            auto megapixels = static_cast<double>(PIXEL_COUNT) * iterationCount / 1000000.0;
+            std::printf(
+                "%-8s %-8s %10.1f Mpixels/s  %s\n", kernel.Name, implementation->Name, megapixels / seconds,
+                exact ? "exact" : "MISMATCH");
+        }
+    }
+    return allExact ? EXITCODE_OK : EXITCODE_FAIL;
+}
@@ -32,44 +32,48 @@
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <string>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+static void fixup_pointers(std::vector<RecordedPaintSession>& s)
 {
-    for (size_t i = 0; i < paint_session_entries; i++)
+    for (auto& session : s)
     {
-        for (size_t j = 0; j < paint_struct_entries; j++)
+        auto& entries = session.Entries;
+        const auto paintStructEntries = entries.size();
+        for (auto& entry : entries)
         {
-            if (s[i].PaintStructs[j].basic.next_quadrant_ps == (paint_struct*)paint_struct_entries)
+            auto& ps = entry.basic;
+            if (ps.next_quadrant_ps == reinterpret_cast<paint_struct*>(paintStructEntries))
             {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = nullptr;
+                ps.next_quadrant_ps = nullptr;
             }
             else
             {
-                auto nextQuadrantPs = reinterpret_cast<uintptr_t>(s[i].PaintStructs[j].basic.next_quadrant_ps);
-                s[i].PaintStructs[j].basic.next_quadrant_ps = &s[i].PaintStructs[nextQuadrantPs].basic;
+                auto nextQuadrantPs = reinterpret_cast<size_t>(ps.next_quadrant_ps);
+                ps.next_quadrant_ps = &entries[nextQuadrantPs].basic;
             }
         }
-        for (size_t j = 0; j < quadrant_entries; j++)
+        for (auto& quad : session.Session.Quadrants)
         {
-            if (s[i].Quadrants[j] == (paint_struct*)quadrant_entries)
+            if (quad == reinterpret_cast<paint_struct*>(paintStructEntries))
             {
-                s[i].Quadrants[j] = nullptr;
+                quad = nullptr;
             }
             else
             {
-                s[i].Quadrants[j] = &s[i].PaintStructs[(size_t)s[i].Quadrants[j]].basic;
+                quad = &entries[reinterpret_cast<size_t>(quad)].basic;
             }
         }
     }
 }
 
-static std::vector<paint_session> extract_paint_session(const std::string parkFileName)
+static std::vector<RecordedPaintSession> extract_paint_session(const std::string parkFileName)
 {
     core_init();
     gOpenRCT2Headless = true;
     auto context = OpenRCT2::CreateContext();
-    std::vector<paint_session> sessions;
+    std::vector<RecordedPaintSession> sessions;
     log_info("Starting...");
     if (context->Initialise())
     {
@@ -133,41 +137,70 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
 }
 
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions, void (*arrange)(PaintSessionCore*))
 {
-    std::vector<paint_session> sessions = inputSessions;
+    auto sessions = inputSessions;
     // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
-    // Keep in mind we need bit-exact copy, as the lists use pointers.
+    // Keep in mind we need bit-exact copy, as the lists use pointers into the entries of `sessions`.
     // Once sorted, just restore the copy with the original fixed-up version.
-    paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
-    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+    fixup_pointers(sessions);
+    auto local_s = sessions;
     for (auto _ : state)
     {
         state.PauseTiming();
-        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        for (size_t i = 0; i < sessions.size(); i++)
+        {
+            sessions[i].Session = local_s[i].Session;
+            std::copy(local_s[i].Entries.begin(), local_s[i].Entries.end(), sessions[i].Entries.begin());
+        }
         state.ResumeTiming();
-        paint_session_arrange(&sessions[0]);
+        arrange(&sessions[0].Session);
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
-    delete[] local_s;
 }
 
-static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
+static std::vector<size_t> get_paint_session_order(const RecordedPaintSession& session)
 {
+    std::vector<size_t> order;
+    for (auto ps = session.Session.PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
     {
-        // Register some basic "baseline" benchmark
-        std::vector<paint_session> sessions(1);
-        for (auto& ps : sessions[0].PaintStructs)
+        order.push_back(reinterpret_cast<const paint_entry*>(ps) - session.Entries.data());
+    }
+    return order;
+}
+
+// Checks that the arranged draw order of every session matches the original linked list sort.
+static bool verify_paint_session_arrange(const std::vector<RecordedPaintSession>& inputSessions)
+{
+    auto sessions = inputSessions;
+    auto referenceSessions = inputSessions;
+    fixup_pointers(sessions);
+    fixup_pointers(referenceSessions);
+    for (size_t i = 0; i < sessions.size(); i++)
+    {
+        paint_session_arrange(&sessions[i].Session);
+        paint_session_arrange_reference(&referenceSessions[i].Session);
+        if (get_paint_session_order(sessions[i]) != get_paint_session_order(referenceSessions[i]))
         {
-            ps.basic.next_quadrant_ps = (paint_struct*)(std::size(sessions[0].PaintStructs));
+            log_error("Paint session %zu is drawn in a different order.", i);
+            return false;
         }
-        for (auto& quad : sessions[0].Quadrants)
+    }
+    return true;
+}
+
+static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
+{
+    {
+        // Register some basic "baseline" benchmark
+        std::vector<RecordedPaintSession> sessions(1);
+        for (auto& quad : sessions[0].Session.Quadrants)
         {
-            quad = (paint_struct*)(std::size(sessions[0].Quadrants));
+            quad = reinterpret_cast<paint_struct*>(sessions[0].Entries.size());
         }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions, paint_session_arrange);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -183,9 +216,19 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         if (Platform::FileExists(argv[i]))
         {
             // Register benchmark for sv6 if valid
-            std::vector<paint_session> sessions = extract_paint_session(argv[i]);
+            auto sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                if (!verify_paint_session_arrange(sessions))
+                {
+                    log_error("Draw order of %s differs from the reference sort.", argv[i]);
+                    return -1;
+                }
+                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions, paint_session_arrange);
+                benchmark::RegisterBenchmark(
+                    (std::string(argv[i]) + " (reference)").c_str(), BM_paint_session_arrange, sessions,
+                    paint_session_arrange_reference);
+            }
         }
         else
         {
@@ -119,6 +119,7 @@ namespace CommandLine
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand SimulateBatchCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -11,23 +11,92 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../TickProfiler.h"
 #include "../core/Console.hpp"
+#include "../core/FileScanner.h"
+#include "../core/JobPool.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../network/network.h"
+#include "../platform/Platform2.h"
 #include "../platform/platform.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <mutex>
+#    include <sys/resource.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
 
 using namespace OpenRCT2;
 
+static utf8* _profilePath = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_STRING, &_profilePath, NAC, "profile", "write the time spent in each stage of every tick to a CSV file" },
+    OptionTableEnd
+};
+// clang-format on
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator);
 
 const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+                                                          DefineCommand("", "<ticks>", SimulateOptions, HandleSimulate), CommandTableEnd
 };
 
+const CommandLineCommand CommandLine::SimulateBatchCommands[]{
+    // Main commands
+    DefineCommand("", "<directory> <ticks> [jobs]", nullptr, HandleSimulateBatch), CommandTableEnd
+};
+
+static constexpr const char* SIMULATE_OUTPUT_CHECKSUM = "Completed: ";
+static constexpr const char* SIMULATE_OUTPUT_TICK_RATE = "Ticks per second: ";
+
+static void WriteProfileHeader(FILE* file)
+{
+    fputs("tick", file);
+    for (size_t i = 0; i < static_cast<size_t>(TickStage::Count); i++)
+    {
+        fprintf(file, ",%s_us", TickProfiler::GetStageName(static_cast<TickStage>(i)));
+    }
+    for (const auto& entityCount : TickProfiler::GetEntityCounts())
+    {
+        fprintf(file, ",%s", entityCount.Name);
+    }
+    fputc('\n', file);
+}
+
+static void WriteProfileRow(FILE* file, uint32_t tick)
+{
+    fprintf(file, "%u", tick);
+    for (auto time : TickProfiler::GetLastTick())
+    {
+        fprintf(file, ",%.3f", time);
+    }
+    for (const auto& entityCount : TickProfiler::GetEntityCounts())
+    {
+        fprintf(file, ",%u", entityCount.Count);
+    }
+    fputc('\n', file);
+}
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
     const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
@@ -58,12 +127,37 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
             return EXITCODE_FAIL;
         }
 
+        FILE* profileFile = nullptr;
+        if (_profilePath != nullptr)
+        {
+            profileFile = fopen(_profilePath, "wt");
+            if (profileFile == nullptr)
+            {
+                Console::Error::WriteLine("Unable to open '%s' for writing.", _profilePath);
+                return EXITCODE_FAIL;
+            }
+            WriteProfileHeader(profileFile);
+            TickProfiler::Reset();
+            TickProfiler::SetEnabled(true);
+        }
+
         Console::WriteLine("Running %d ticks...", ticks);
+        auto startTime = std::chrono::steady_clock::now();
         for (uint32_t i = 0; i < ticks; i++)
         {
             context->GetGameState()->UpdateLogic();
+            if (profileFile != nullptr)
+            {
+                WriteProfileRow(profileFile, i);
+            }
         }
-        Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+        if (profileFile != nullptr)
+        {
+            fclose(profileFile);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        Console::WriteLine("%s%s", SIMULATE_OUTPUT_CHECKSUM, sprite_checksum().ToString().c_str());
+        Console::WriteLine("%s%.2f", SIMULATE_OUTPUT_TICK_RATE, elapsed.count() > 0 ? ticks / elapsed.count() : 0.0);
     }
     else
     {
@@ -73,3 +167,175 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+struct SimulateBatchResult
+{
+    std::string Path;
+    bool Success{};
+    std::string Checksum;
+    double TicksPerSecond{};
+    uint64_t PeakMemoryKiB{};
+    double WallSeconds{};
+};
+
+#ifndef _WIN32
+/**
+ * Every park runs in its own process: the game state lives in globals, so two parks can not be simulated side by side
+ * within one process. The child is this executable running the plain simulate command.
+ */
+static void RunSimulateProcess(const std::string& exePath, uint32_t ticks, SimulateBatchResult& result)
+{
+    // Children are spawned from several threads, hold a lock so that no other child inherits a pipe before it is
+    // marked close-on-exec.
+    static std::mutex spawnMutex;
+
+    auto ticksArg = std::to_string(ticks);
+    const char* args[] = { exePath.c_str(), "simulate", result.Path.c_str(), ticksArg.c_str(), nullptr };
+
+    auto startTime = std::chrono::steady_clock::now();
+    int fds[2];
+    pid_t pid;
+    {
+        std::lock_guard<std::mutex> lock(spawnMutex);
+        if (pipe(fds) != 0)
+        {
+            return;
+        }
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+        pid = fork();
+        if (pid == 0)
+        {
+            dup2(fds[1], STDOUT_FILENO);
+            execv(args[0], const_cast<char* const*>(args));
+            _exit(127);
+        }
+    }
+    close(fds[1]);
+    if (pid == -1)
+    {
+        close(fds[0]);
+        return;
+    }
+
+    std::string output;
+    char buffer[1024];
+    for (;;)
+    {
+        auto bytesRead = read(fds[0], buffer, sizeof(buffer));
+        if (bytesRead > 0)
+        {
+            output.append(buffer, bytesRead);
+        }
+        else if (bytesRead == 0 || errno != EINTR)
+        {
+            break;
+        }
+    }
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage = {};
+    while (wait4(pid, &status, 0, &usage) == -1 && errno == EINTR)
+    {
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    result.WallSeconds = elapsed.count();
+#    ifdef __APPLE__
+    result.PeakMemoryKiB = static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#    else
+    result.PeakMemoryKiB = static_cast<uint64_t>(usage.ru_maxrss);
+#    endif
+
+    size_t lineStart = 0;
+    while (lineStart < output.size())
+    {
+        auto lineEnd = output.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+        {
+            lineEnd = output.size();
+        }
+        auto line = output.substr(lineStart, lineEnd - lineStart);
+        if (String::StartsWith(line.c_str(), SIMULATE_OUTPUT_CHECKSUM))
+        {
+            result.Checksum = String::Trim(line.substr(strlen(SIMULATE_OUTPUT_CHECKSUM)));
+        }
+        else if (String::StartsWith(line.c_str(), SIMULATE_OUTPUT_TICK_RATE))
+        {
+            result.TicksPerSecond = atof(line.c_str() + strlen(SIMULATE_OUTPUT_TICK_RATE));
+        }
+        lineStart = lineEnd + 1;
+    }
+    result.Success = WIFEXITED(status) && WEXITSTATUS(status) == 0 && !result.Checksum.empty();
+}
+#endif
+
+static exitcode_t HandleSimulateBatch(CommandLineArgEnumerator* argEnumerator)
+{
+#ifdef _WIN32
+    Console::Error::WriteLine("simulate-batch is not supported on this platform.");
+    return EXITCODE_FAIL;
+#else
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <directory> <ticks>.");
+        return EXITCODE_FAIL;
+    }
+
+    std::string directory = argv[0];
+    uint32_t ticks = atol(argv[1]);
+    size_t jobs = argc >= 3 ? std::max(atol(argv[2]), 1L) : std::thread::hardware_concurrency();
+
+    std::vector<SimulateBatchResult> results;
+    {
+        auto pattern = Path::Combine(directory, "*.sv6;*.sc6;*.SV6;*.SC6");
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(pattern, false));
+        while (scanner->Next())
+        {
+            SimulateBatchResult result;
+            result.Path = scanner->GetPath();
+            results.push_back(std::move(result));
+        }
+    }
+    if (results.empty())
+    {
+        Console::Error::WriteLine("No parks found in '%s'.", directory.c_str());
+        return EXITCODE_FAIL;
+    }
+    std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) { return a.Path < b.Path; });
+
+    auto exePath = Platform::GetCurrentExecutablePath();
+    auto startTime = std::chrono::steady_clock::now();
+    JobPool jobPool(jobs);
+    jobPool.ParallelFor(results.size(), [&](size_t i) { RunSimulateProcess(exePath, ticks, results[i]); });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    bool allSucceeded = true;
+    json_t jParks = json_t::array();
+    for (const auto& result : results)
+    {
+        allSucceeded &= result.Success;
+        jParks.push_back({
+            { "path", result.Path },
+            { "success", result.Success },
+            { "checksum", result.Checksum },
+            { "ticksPerSecond", result.TicksPerSecond },
+            { "peakMemoryKiB", result.PeakMemoryKiB },
+            { "wallSeconds", result.WallSeconds },
+        });
+    }
+    json_t jReport = {
+        { "ticks", ticks },
+        { "jobs", jobPool.CountThreads() },
+        { "wallSeconds", elapsed.count() },
+        { "parks", jParks },
+    };
+    Console::WriteLine("%s", jReport.dump(4).c_str());
+
+    return allSucceeded ? EXITCODE_OK : EXITCODE_FAIL;
+#endif
+}
@@ -199,6 +199,10 @@ namespace Config
                 "scale_quality", ScaleQuality::SmoothNearestNeighbour, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->cache_viewports = reader->GetBoolean("cache_viewports", false);
+            model->cached_pathfinding = reader->GetBoolean("cached_pathfinding", false);
+            model->lazy_load_images = reader->GetBoolean("lazy_load_images", false);
+            model->lazy_image_budget = reader->GetInt32("lazy_image_budget", 128);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -274,6 +278,10 @@ namespace Config
         writer->WriteEnum<ScaleQuality>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("cache_viewports", model->cache_viewports);
+        writer->WriteBoolean("cached_pathfinding", model->cached_pathfinding);
+        writer->WriteBoolean("lazy_load_images", model->lazy_load_images);
+        writer->WriteInt32("lazy_image_budget", model->lazy_image_budget);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -407,6 +415,7 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->map_compression_level = reader->GetInt32("map_compression_level", 6);
         }
     }
 
@@ -434,6 +443,7 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("map_compression_level", model->map_compression_level);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -41,6 +41,10 @@ struct GeneralConfiguration
     bool use_vsync;
     bool show_fps;
     bool multithreading;
+    bool cache_viewports;
+    bool cached_pathfinding;
+    bool lazy_load_images;
+    int32_t lazy_image_budget;
     bool minimize_fullscreen_focus_loss;
 
     // Map rendering
@@ -158,6 +162,7 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t map_compression_level;
 };
 
 struct NotificationConfiguration
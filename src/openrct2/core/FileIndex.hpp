@@ -15,37 +15,42 @@
 #include "FileScanner.h"
 #include "FileStream.hpp"
 #include "JobPool.hpp"
+#include "MemoryMappedFile.h"
 #include "Path.hpp"
 
 #include <chrono>
-#include <list>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
 {
 private:
-    struct DirectoryStats
+    struct ScannedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
     };
 
-    struct ScanResult
+    /**
+     * What is known about a file from the last time it was indexed. The file is only loaded again if its size or
+     * modification time changed, and then only re-parsed if its content did too.
+     */
+    struct IndexRecord
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
-            : Stats(stats)
-            , Files(files)
-        {
-        }
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        uint64_t ContentHash = 0;
+        // False for files that could not be loaded, so they are not retried until they change.
+        bool HasItem = false;
+        TItem Item{};
     };
 
+    using IndexRecords = std::unordered_map<std::string, IndexRecord>;
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -53,12 +58,11 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumRecords = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -94,32 +98,20 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files that are unchanged since the index was written are
+     * taken from the index, only new and modified files are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+        auto files = Scan();
+        auto records = ReadIndexFile(language);
+        return Build(language, files, std::move(records));
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        auto files = Scan();
+        return Build(language, files, {});
     }
 
 protected:
@@ -140,10 +132,9 @@ protected:
     virtual TItem Deserialise(OpenRCT2::IStream* stream) const abstract;
 
 private:
-    ScanResult Scan() const
+    std::vector<ScannedFile> Scan() const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -154,108 +145,119 @@ private:
             while (scanner->Next())
             {
                 auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
-                files.push_back(path);
-
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo->LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo->LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                files.push_back({ std::string(scanner->GetPath()), fileInfo->Size, fileInfo->LastModified });
             }
             delete scanner;
         }
-        return ScanResult(stats, files);
+        return files;
     }
 
-    void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+    std::vector<TItem> Build(int32_t language, const std::vector<ScannedFile>& files, IndexRecords&& previousRecords) const
     {
-        items.reserve(rangeEnd - rangeStart);
-        for (size_t i = rangeStart; i < rangeEnd; i++)
-        {
-            const auto& filePath = scanResult.Files.at(i);
+        auto startTime = std::chrono::high_resolution_clock::now();
 
-            if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
+        // Take over the records of unchanged files, the rest has to be looked at again.
+        const size_t totalCount = files.size();
+        std::vector<IndexRecord> records(totalCount);
+        std::vector<size_t> changedFiles;
+        for (size_t i = 0; i < totalCount; i++)
+        {
+            const auto& file = files[i];
+            auto it = previousRecords.find(file.Path);
+            if (it != previousRecords.end() && it->second.Size == file.Size && it->second.LastModified == file.LastModified)
             {
-                std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                records[i] = std::move(it->second);
+                previousRecords.erase(it);
             }
-
-            auto item = Create(language, filePath);
-            if (std::get<0>(item))
+            else
             {
-                items.push_back(std::get<1>(item));
+                changedFiles.push_back(i);
             }
-
-            processed++;
         }
-    }
-
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
-    {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
 
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        // Records left over belong to files that were modified or removed.
+        bool indexChanged = !changedFiles.empty() || !previousRecords.empty();
+        if (!changedFiles.empty())
         {
+            Console::WriteLine("Building %s (%zu of %zu items)", _name.c_str(), changedFiles.size(), totalCount);
+
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
-
-            std::list<std::vector<TItem>> containers;
-
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
-
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+            std::atomic<size_t> parsed = ATOMIC_VAR_INIT(0);
+            const size_t changedCount = changedFiles.size();
 
             auto reportProgress = [&]() {
                 const size_t completed = processed;
-                Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
+                Console::WriteFormat(
+                    "File %5zu of %zu, done %3d%%\r", completed, changedCount, completed * 100 / changedCount);
             };
 
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
-            {
-                if (rangeStart + stepSize > totalCount)
-                {
-                    stepSize = totalCount - rangeStart;
-                }
-
-                auto& items = containers.emplace_back();
-
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
-
-                reportProgress();
-            }
+            // The pool splits the files into ranges on demand, so idle threads take over work of busy ones
+            // instead of waiting for fixed size batches.
+            jobPool.ParallelFor(
+                changedCount,
+                [&](size_t j) {
+                    const size_t i = changedFiles[j];
+                    const auto& file = files[i];
+                    auto& record = records[i];
+                    record.Size = file.Size;
+                    record.LastModified = file.LastModified;
+
+                    // A file that was only touched keeps its item, it does not have to be parsed again.
+                    auto contentHash = GetContentHash(file.Path);
+                    auto it = previousRecords.find(file.Path);
+                    if (contentHash != std::nullopt && it != previousRecords.end() && it->second.Size == file.Size
+                        && it->second.ContentHash == *contentHash)
+                    {
+                        record.ContentHash = *contentHash;
+                        record.HasItem = it->second.HasItem;
+                        record.Item = it->second.Item;
+                    }
+                    else
+                    {
+                        if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
+                        {
+                            std::lock_guard<std::mutex> lock(printLock);
+                            log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
+                        }
+
+                        auto result = Create(language, file.Path);
+                        record.ContentHash = contentHash.value_or(0);
+                        record.HasItem = std::get<0>(result);
+                        record.Item = std::move(std::get<1>(result));
+                        parsed++;
+                    }
+                    processed++;
+                },
+                1, reportProgress);
+
+            auto duration = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime);
+            Console::WriteLine(
+                "Finished building %s in %.2f seconds, %zu files parsed.", _name.c_str(), duration.count(),
+                static_cast<size_t>(parsed));
+        }
 
-            jobPool.Join(reportProgress);
+        if (indexChanged)
+        {
+            WriteIndexFile(language, files, records);
+        }
 
-            for (auto&& itr : containers)
+        // Keep the order of the scanned files.
+        std::vector<TItem> allItems;
+        for (auto& record : records)
+        {
+            if (record.HasItem)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                allItems.push_back(std::move(record.Item));
             }
         }
-
-        WriteIndexFile(language, scanResult.Stats, allItems);
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
-
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    IndexRecords ReadIndexFile(int32_t language) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        IndexRecords records;
         if (File::Exists(_indexPath))
         {
             try
@@ -263,22 +265,26 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, records of a different format or language can not be used
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    records.reserve(header.NumRecords);
+                    for (uint32_t i = 0; i < header.NumRecords; i++)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        auto path = fs.ReadStdString();
+                        IndexRecord record;
+                        record.Size = fs.ReadValue<uint64_t>();
+                        record.LastModified = fs.ReadValue<uint64_t>();
+                        record.ContentHash = fs.ReadValue<uint64_t>();
+                        record.HasItem = fs.ReadValue<uint8_t>() != 0;
+                        if (record.HasItem)
+                        {
+                            record.Item = Deserialise(&fs);
+                        }
+                        records.emplace(std::move(path), std::move(record));
                     }
-                    loadedItems = true;
                 }
                 else
                 {
@@ -289,12 +295,13 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                records.clear();
             }
         }
-        return std::make_tuple(loadedItems, items);
+        return records;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const std::vector<ScannedFile>& files, const std::vector<IndexRecord>& records) const
     {
         try
         {
@@ -308,14 +315,22 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumRecords = static_cast<uint32_t>(records.size());
             fs.WriteValue(header);
 
-            // Write items
-            for (const auto& item : items)
+            // Write records
+            for (size_t i = 0; i < records.size(); i++)
             {
-                Serialise(&fs, item);
+                const auto& record = records[i];
+                fs.WriteString(files[i].Path);
+                fs.WriteValue<uint64_t>(record.Size);
+                fs.WriteValue<uint64_t>(record.LastModified);
+                fs.WriteValue<uint64_t>(record.ContentHash);
+                fs.WriteValue<uint8_t>(record.HasItem ? 1 : 0);
+                if (record.HasItem)
+                {
+                    Serialise(&fs, record.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -325,18 +340,24 @@ private:
         }
     }
 
-    static uint32_t GetPathChecksum(const std::string& path)
+    static std::optional<uint64_t> GetContentHash(const std::string& path)
     {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
+        try
+        {
+            // FNV-1a over the mapped file, it only has to notice that a file's content changed.
+            auto file = OpenRCT2::MemoryMappedFile(path);
+            const uint8_t* data = file.GetData();
+            uint64_t hash = 14695981039346656037ULL;
+            for (size_t i = 0; i < file.GetLength(); i++)
+            {
+                hash ^= data[i];
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+        catch (const std::exception&)
         {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
+            return std::nullopt;
         }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
     }
 };
@@ -10,48 +10,249 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+/**
+ * Fixed capacity single producer, multiple consumer deque (Chase-Lev). The owning thread pushes and pops
+ * at the bottom, any other thread may steal from the top without taking a lock.
+ */
+template<typename T, size_t TCapacity> class WorkStealingDeque
+{
+    static_assert((TCapacity & (TCapacity - 1)) == 0, "Capacity must be a power of two.");
+
+private:
+    static constexpr int64_t Mask = static_cast<int64_t>(TCapacity - 1);
+
+    alignas(64) std::atomic<int64_t> _top = { 0 };
+    alignas(64) std::atomic<int64_t> _bottom = { 0 };
+    std::array<std::atomic<T*>, TCapacity> _items{};
+
+public:
+    /**
+     * Pushes an item to the bottom, may only be called by the owning thread.
+     * Returns false if the deque is full.
+     */
+    bool Push(T* item)
+    {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<int64_t>(TCapacity))
+        {
+            return false;
+        }
+        _items[b & Mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Pops the most recently pushed item, may only be called by the owning thread.
+     */
+    T* Pop()
+    {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+
+        T* item = nullptr;
+        if (t <= b)
+        {
+            item = _items[b & Mask].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Last item, race against thieves.
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * Takes the oldest item, can be called from any thread.
+     */
+    T* Steal()
+    {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t < b)
+        {
+            T* item = _items[t & Mask].load(std::memory_order_relaxed);
+            if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t Size() const
+    {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+};
+
+/**
+ * Work-stealing thread pool. Every worker owns a deque of tasks, idle workers steal from the others.
+ * The thread that owns the pool (the one calling AddTask, ParallelFor and Join) has its own deque and
+ * helps executing tasks while it waits in Join. The public methods may only be called from that thread.
+ */
 class JobPool
 {
+public:
+    struct Stats
+    {
+        uint64_t TasksExecuted = 0;
+        uint64_t Steals = 0;
+        uint64_t IdleMicroseconds = 0;
+        size_t PeakQueueDepth = 0;
+    };
+
 private:
-    struct TaskData
+    static constexpr size_t TaskInlineStorageSize = 48;
+    static constexpr size_t TaskBlockSize = 256;
+    static constexpr size_t QueueCapacity = 1024;
+    static constexpr size_t SpinCount = 64;
+
+    struct Task
+    {
+        void (*Invoke)(Task& task, size_t queueIndex) = nullptr;
+        void (*Destroy)(Task& task) = nullptr;
+        std::function<void()> CompletionFn;
+        alignas(std::max_align_t) unsigned char Storage[TaskInlineStorageSize];
+    };
+
+    // Tasks are never freed individually, each queue owns an arena that is recycled once the pool is idle.
+    struct TaskArena
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+        std::vector<std::unique_ptr<Task[]>> Blocks;
+        size_t Count = 0;
+
+        Task& Allocate()
+        {
+            const size_t blockIndex = Count / TaskBlockSize;
+            if (blockIndex >= Blocks.size())
+            {
+                Blocks.push_back(std::make_unique<Task[]>(TaskBlockSize));
+            }
+            return Blocks[blockIndex][Count++ % TaskBlockSize];
+        }
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-            : WorkFn(workFn)
-            , CompletionFn(completionFn)
+        template<typename TFn> void ForEach(TFn&& fn)
+        {
+            for (size_t i = 0; i < Count; i++)
+            {
+                fn(Blocks[i / TaskBlockSize][i % TaskBlockSize]);
+            }
+        }
+    };
+
+    struct alignas(64) Queue
+    {
+        WorkStealingDeque<Task, QueueCapacity> Tasks;
+        TaskArena Arena;
+        std::atomic<uint64_t> TasksExecuted = { 0 };
+        std::atomic<uint64_t> Steals = { 0 };
+        std::atomic<uint64_t> IdleMicroseconds = { 0 };
+    };
+
+    struct InvokeWithoutIndex
+    {
+        template<typename TFn> void operator()(TFn& fn, size_t) const
+        {
+            fn();
+        }
+    };
+
+    struct InvokeWithIndex
+    {
+        template<typename TFn> void operator()(TFn& fn, size_t queueIndex) const
         {
+            fn(queueIndex);
+        }
+    };
+
+    template<typename TFn> struct RangeTask
+    {
+        JobPool* Pool;
+        TFn* Fn;
+        size_t Begin;
+        size_t End;
+        size_t GrainSize;
+
+        void operator()(size_t queueIndex)
+        {
+            // Lazily split the range, the upper halves can be stolen by idle workers.
+            while (End - Begin > GrainSize)
+            {
+                const size_t mid = Begin + (End - Begin) / 2;
+                if (!Pool->TryPush(queueIndex, RangeTask{ Pool, Fn, mid, End, GrainSize }))
+                {
+                    break;
+                }
+                End = mid;
+            }
+            for (size_t i = Begin; i < End; i++)
+            {
+                (*Fn)(i);
+            }
         }
     };
 
     std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    std::atomic<int64_t> _queued = { 0 };
+    std::atomic<int64_t> _outstanding = { 0 };
+    std::atomic<size_t> _sleeping = { 0 };
+    std::atomic<size_t> _peakQueueDepth = { 0 };
+    std::vector<std::unique_ptr<Queue>> _queues;
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
     std::condition_variable _condPending;
     std::condition_variable _condComplete;
     std::mutex _mutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
+    using clock = std::chrono::steady_clock;
 
 public:
     JobPool(size_t maxThreads = 255)
     {
+        // The owning thread takes part in the work while joining so it counts towards the thread limit.
         maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
-        for (size_t n = 0; n < maxThreads; n++)
+        const size_t numWorkers = maxThreads > 0 ? maxThreads - 1 : 0;
+
+        for (size_t n = 0; n <= numWorkers; n++)
+        {
+            _queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t n = 1; n <= numWorkers; n++)
         {
-            _threads.emplace_back(&JobPool::ProcessQueue, this);
+            _threads.emplace_back(&JobPool::ProcessQueue, this, n);
         }
     }
 
@@ -68,50 +269,104 @@ public:
             assert(th.joinable() != false);
             th.join();
         }
+
+        for (auto& queue : _queues)
+        {
+            queue->Arena.ForEach([](Task& task) { task.Destroy(task); });
+        }
     }
 
-    void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr)
+    template<typename TWorkFn> void AddTask(TWorkFn&& workFn, std::function<void()> completionFn = nullptr)
     {
-        unique_lock lock(_mutex);
-        _pending.emplace_back(workFn, completionFn);
-        _condPending.notify_one();
+        auto& task = EmplaceTask<InvokeWithoutIndex>(_queues[0]->Arena, std::forward<TWorkFn>(workFn));
+        task.CompletionFn = std::move(completionFn);
+        if (!Push(0, task))
+        {
+            // Our queue is full, run it straight away instead.
+            task.Invoke(task, 0);
+        }
+    }
+
+    /**
+     * Calls fn(i) for every i in [0, count) spread over all threads and blocks until all work in the pool
+     * has completed. Ranges smaller than grainSize are not split any further.
+     */
+    template<typename TFn>
+    void ParallelFor(size_t count, TFn&& fn, size_t grainSize = 1, std::function<void()> reportFn = nullptr)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        using TBody = std::remove_reference_t<TFn>;
+        RangeTask<TBody> root{ this, &fn, 0, count, std::max<size_t>(grainSize, 1) };
+        if (!TryPush(0, root))
+        {
+            root(0);
+        }
+        Join(reportFn);
     }
 
     void Join(std::function<void()> reportFn = nullptr)
     {
-        unique_lock lock(_mutex);
         while (true)
         {
-            // Wait for the queue to become empty or having completed tasks.
-            _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
-
-            // Dispatch all completion callbacks if there are any.
-            while (!_completed.empty())
+            auto lastReport = clock::now();
+            while (_outstanding.load(std::memory_order_acquire) != 0)
             {
-                auto taskData = _completed.front();
-                _completed.pop_front();
-
-                if (taskData.CompletionFn)
+                auto* task = _queues[0]->Tasks.Pop();
+                if (task == nullptr)
                 {
-                    lock.unlock();
+                    task = TrySteal(0);
+                }
 
-                    taskData.CompletionFn();
+                if (task != nullptr)
+                {
+                    Execute(*task, 0);
+                }
+                else
+                {
+                    // Everything left is already running on the workers.
+                    unique_lock lock(_mutex);
+                    _condComplete.wait_for(
+                        lock, std::chrono::milliseconds(10), [this]() { return _outstanding.load() == 0 || _queued.load() > 0; });
+                }
 
-                    lock.lock();
+                if (reportFn && clock::now() - lastReport >= std::chrono::milliseconds(50))
+                {
+                    reportFn();
+                    lastReport = clock::now();
                 }
             }
 
-            if (reportFn)
+            // All tasks have finished, recycle the arenas and dispatch the completion callbacks.
+            std::vector<std::function<void()>> completions;
+            for (auto& queue : _queues)
             {
-                lock.unlock();
+                queue->Arena.ForEach([&completions](Task& task) {
+                    if (task.CompletionFn)
+                    {
+                        completions.push_back(std::move(task.CompletionFn));
+                        task.CompletionFn = nullptr;
+                    }
+                    task.Destroy(task);
+                });
+                queue->Arena.Count = 0;
+            }
 
-                reportFn();
+            for (auto& completionFn : completions)
+            {
+                completionFn();
+            }
 
-                lock.lock();
+            if (reportFn)
+            {
+                reportFn();
             }
 
-            // If everything is empty and no more work has to be done we can stop waiting.
-            if (_completed.empty() && _pending.empty() && _processing == 0)
+            // Completion callbacks are allowed to queue more work.
+            if (_outstanding.load(std::memory_order_acquire) == 0)
             {
                 break;
             }
@@ -120,36 +375,164 @@ public:
 
     size_t CountPending()
     {
-        return _pending.size();
+        return static_cast<size_t>(std::max<int64_t>(_queued.load(), 0));
+    }
+
+    size_t CountThreads() const
+    {
+        return _queues.size();
+    }
+
+    Stats GetStats() const
+    {
+        Stats stats;
+        for (const auto& queue : _queues)
+        {
+            stats.TasksExecuted += queue->TasksExecuted.load(std::memory_order_relaxed);
+            stats.Steals += queue->Steals.load(std::memory_order_relaxed);
+            stats.IdleMicroseconds += queue->IdleMicroseconds.load(std::memory_order_relaxed);
+        }
+        stats.PeakQueueDepth = _peakQueueDepth.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        for (auto& queue : _queues)
+        {
+            queue->TasksExecuted.store(0, std::memory_order_relaxed);
+            queue->Steals.store(0, std::memory_order_relaxed);
+            queue->IdleMicroseconds.store(0, std::memory_order_relaxed);
+        }
+        _peakQueueDepth.store(0, std::memory_order_relaxed);
     }
 
 private:
-    void ProcessQueue()
+    template<typename TCall, typename TFn> static Task& EmplaceTask(TaskArena& arena, TFn&& fn)
     {
-        unique_lock lock(_mutex);
-        do
+        using TStored = std::decay_t<TFn>;
+
+        auto& task = arena.Allocate();
+        if constexpr (sizeof(TStored) <= TaskInlineStorageSize && alignof(TStored) <= alignof(std::max_align_t))
         {
-            // Wait for work or cancelation.
-            _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+            new (task.Storage) TStored(std::forward<TFn>(fn));
+            task.Invoke = [](Task& t, size_t queueIndex) {
+                TCall()(*std::launder(reinterpret_cast<TStored*>(t.Storage)), queueIndex);
+            };
+            task.Destroy = [](Task& t) { std::launder(reinterpret_cast<TStored*>(t.Storage))->~TStored(); };
+        }
+        else
+        {
+            // Too big for the inline storage, fall back to the heap.
+            new (task.Storage) TStored*(new TStored(std::forward<TFn>(fn)));
+            task.Invoke = [](Task& t, size_t queueIndex) {
+                TCall()(**std::launder(reinterpret_cast<TStored**>(t.Storage)), queueIndex);
+            };
+            task.Destroy = [](Task& t) { delete *std::launder(reinterpret_cast<TStored**>(t.Storage)); };
+        }
+        return task;
+    }
 
-            if (!_pending.empty())
-            {
-                _processing++;
+    template<typename TFn> bool TryPush(size_t queueIndex, TFn&& fn)
+    {
+        auto& queue = *_queues[queueIndex];
+        if (queue.Tasks.Size() >= QueueCapacity)
+        {
+            return false;
+        }
+        auto& task = EmplaceTask<InvokeWithIndex>(queue.Arena, std::forward<TFn>(fn));
+        return Push(queueIndex, task);
+    }
+
+    bool Push(size_t queueIndex, Task& task)
+    {
+        _outstanding.fetch_add(1, std::memory_order_relaxed);
+        const auto depth = static_cast<size_t>(_queued.fetch_add(1) + 1);
+        if (!_queues[queueIndex]->Tasks.Push(&task))
+        {
+            _queued.fetch_sub(1);
+            _outstanding.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
 
-                auto taskData = _pending.front();
-                _pending.pop_front();
+        auto peak = _peakQueueDepth.load(std::memory_order_relaxed);
+        while (depth > peak && !_peakQueueDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed))
+        {
+        }
+
+        if (_sleeping.load() > 0)
+        {
+            // Taking the lock ensures the worker is either waiting or will see the new task.
+            unique_lock lock(_mutex);
+            _condPending.notify_one();
+        }
+        return true;
+    }
 
-                lock.unlock();
+    Task* TrySteal(size_t thiefIndex)
+    {
+        const size_t numQueues = _queues.size();
+        for (size_t i = 1; i < numQueues; i++)
+        {
+            auto& victim = *_queues[(thiefIndex + i) % numQueues];
+            auto* task = victim.Tasks.Steal();
+            if (task != nullptr)
+            {
+                _queues[thiefIndex]->Steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
 
-                taskData.WorkFn();
+    void Execute(Task& task, size_t queueIndex)
+    {
+        _queued.fetch_sub(1);
+        task.Invoke(task, queueIndex);
+        _queues[queueIndex]->TasksExecuted.fetch_add(1, std::memory_order_relaxed);
 
-                lock.lock();
+        if (_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            unique_lock lock(_mutex);
+            _condComplete.notify_all();
+        }
+    }
 
-                _completed.push_back(taskData);
+    void ProcessQueue(size_t queueIndex)
+    {
+        auto& queue = *_queues[queueIndex];
+        size_t spins = 0;
+        while (!_shouldStop)
+        {
+            auto* task = queue.Tasks.Pop();
+            if (task == nullptr)
+            {
+                task = TrySteal(queueIndex);
+            }
 
-                _processing--;
-                _condComplete.notify_one();
+            if (task != nullptr)
+            {
+                Execute(*task, queueIndex);
+                spins = 0;
+            }
+            else if (_queued.load() > 0 || ++spins < SpinCount)
+            {
+                std::this_thread::yield();
             }
-        } while (!_shouldStop);
+            else
+            {
+                // Wait for work or cancelation.
+                const auto idleStart = clock::now();
+                _sleeping.fetch_add(1);
+                {
+                    unique_lock lock(_mutex);
+                    _condPending.wait(lock, [this]() { return _shouldStop || _queued.load() > 0; });
+                }
+                _sleeping.fetch_sub(1);
+                const auto idleTime = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - idleStart);
+                queue.IdleMicroseconds.fetch_add(idleTime.count(), std::memory_order_relaxed);
+                spins = 0;
+            }
+        }
     }
 };
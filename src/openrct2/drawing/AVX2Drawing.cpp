@@ -42,6 +42,65 @@ void mask_avx2(
     }
 }
 
+template<DrawBlendOp TBlendOp, size_t TCount>
+static void blit_run_lookup(const uint8_t* map, uint32_t mapLength, const uint8_t* src, const uint8_t* dst, uint8_t* mapped)
+{
+    for (size_t j = 0; j < TCount; j++)
+    {
+        mapped[j] = BlitPixelValue<TBlendOp>(map, mapLength, src[j], dst[j]);
+    }
+}
+
+template<DrawBlendOp TBlendOp>
+static void blit_run_avx2_op(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    constexpr bool usesMap = (TBlendOp & (BLEND_SRC | BLEND_DST)) != 0;
+    const uint8_t* map = paletteMap.GetData();
+    const uint32_t mapLength = paletteMap.GetLength();
+    int32_t i = 0;
+
+    const __m256i zero = {};
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i pixels = source;
+        __m256i skip = _mm256_cmpeq_epi8(source, zero);
+        if constexpr (usesMap)
+        {
+            alignas(32) uint8_t mapped[32];
+            blit_run_lookup<TBlendOp, 32>(map, mapLength, src + i, dst + i, mapped);
+            pixels = _mm256_load_si256(reinterpret_cast<const __m256i*>(mapped));
+            skip = _mm256_or_si256(skip, _mm256_cmpeq_epi8(pixels, zero));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, skip));
+    }
+
+    // Most runs are shorter than 32 pixels, so finish with a half width block before going scalar.
+    if (i + 16 <= count)
+    {
+        const __m128i zero128 = {};
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i pixels = source;
+        __m128i skip = _mm_cmpeq_epi8(source, zero128);
+        if constexpr (usesMap)
+        {
+            alignas(16) uint8_t mapped[16];
+            blit_run_lookup<TBlendOp, 16>(map, mapLength, src + i, dst + i, mapped);
+            pixels = _mm_load_si128(reinterpret_cast<const __m128i*>(mapped));
+            skip = _mm_or_si128(skip, _mm_cmpeq_epi8(pixels, zero128));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, skip));
+        i += 16;
+    }
+
+    for (; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +114,18 @@ void mask_avx2(
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+template<DrawBlendOp TBlendOp>
+static void blit_run_avx2_op(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
+
+const BlitRunFunctions blit_run_avx2 = {
+    "avx2",
+    blit_run_avx2_op<BLEND_TRANSPARENT>,
+    blit_run_avx2_op<BLEND_TRANSPARENT | BLEND_SRC>,
+    blit_run_avx2_op<BLEND_TRANSPARENT | BLEND_DST>,
+    blit_run_avx2_op<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>,
+};
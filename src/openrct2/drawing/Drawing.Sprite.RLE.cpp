@@ -24,6 +24,7 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     auto& paletteMap = args.PalMap;
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi->width) << TZoom) + dpi->pitch;
+    auto blitRun = blit_run_fns.Get<TBlendOp>();
 
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
@@ -72,12 +73,18 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
             numPixels = std::min(numPixels, width - x);
 
             auto dst = dstLineStart + (static_cast<size_t>(x) << TZoom);
-            while (numPixels > 0)
+            if (numPixels > 0)
             {
-                BlitPixels<TBlendOp>(src, dst, paletteMap, zoom, dstLineWidth);
-                src++;
-                dst += zoom;
-                numPixels--;
+                // Widen the run so each of the zoom destination rows is drawn with a single blitter call
+                uint8_t widened[128 << TZoom];
+                for (int32_t j = 0; j < numPixels; j++)
+                {
+                    std::memset(&widened[j << TZoom], src[j], zoom);
+                }
+                for (int32_t row = 0; row < zoom; row++)
+                {
+                    blitRun(widened, dst + (dstLineWidth * row), numPixels << TZoom, paletteMap);
+                }
             }
         }
     }
@@ -94,6 +101,7 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
     auto height = args.Height;
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi->width) >> TZoom) + dpi->pitch;
+    auto blitRun = blit_run_fns.Get<TBlendOp>();
 
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
@@ -163,15 +171,25 @@ template<DrawBlendOp TBlendOp, size_t TZoom> static void FASTCALL DrawRLESpriteM
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (TZoom == 0)
+            {
+                if (numPixels > 0)
+                {
+                    blitRun(src, dst, numPixels, args.PalMap);
+                }
+            }
             else
             {
-                auto& paletteMap = args.PalMap;
-                while (numPixels > 0)
+                // Gather every zoom'th pixel so the run can be drawn with a single blitter call
+                uint8_t sampled[128];
+                int32_t count = 0;
+                for (int32_t j = 0; j < numPixels; j += zoom)
+                {
+                    sampled[count++] = src[j];
+                }
+                if (count > 0)
                 {
-                    BlitPixel<TBlendOp>(src, dst, paletteMap);
-                    numPixels -= zoom;
-                    src += zoom;
-                    dst++;
+                    blitRun(sampled, dst, count, args.PalMap);
                 }
             }
         }
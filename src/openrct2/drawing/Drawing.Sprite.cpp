@@ -12,6 +12,8 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -20,7 +22,9 @@
 #include "Drawing.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -186,6 +190,44 @@ static rct_g1_element _g1Temp = {};
 static std::vector<rct_g1_element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+struct LazyImageList
+{
+    ILazyImageSource* Source{};
+    size_t BaseIndex{};
+    uint32_t Count{};
+    std::atomic<bool> Loaded{};
+    std::atomic<bool> Failed{};
+    std::atomic<uint32_t> LastUsed{};
+};
+
+// Image lists of lazily loaded objects, images are drawn from the paint threads so loading is guarded by a mutex.
+// Eviction only happens in gfx_trim_lazy_images between frames.
+static std::vector<std::unique_ptr<LazyImageList>> _lazyImageLists;
+// One based index into _lazyImageLists for each image list element, zero for images that are always loaded.
+static std::vector<uint32_t> _imageListLazyIndex;
+static std::mutex _lazyImageMutex;
+static size_t _lazyImageLoadedSize;
+static uint32_t _lazyImageFrame;
+
+/**
+ * Points the element offsets, which are relative to the start of the image data, into the mapped file. The image data
+ * is never copied, so processes sharing the same files also share the pages of the operating system's file cache.
+ */
+static void gfx_map_gx_data(rct_gx& gx, const std::shared_ptr<MemoryMappedFile>& file, size_t dataOffset)
+{
+    if (dataOffset > file->GetLength() || gx.header.total_size > file->GetLength() - dataOffset)
+    {
+        throw std::runtime_error("Image data is shorter than expected.");
+    }
+
+    auto data = const_cast<uint8_t*>(file->GetData() + dataOffset);
+    for (auto& element : gx.elements)
+    {
+        element.offset = data + reinterpret_cast<uintptr_t>(element.offset);
+    }
+    gx.data = file;
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -196,7 +238,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto file = std::make_shared<MemoryMappedFile>(path);
+        auto fs = MemoryStream(file->GetData(), file->GetLength());
         _g1.header = fs.ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
@@ -212,18 +255,12 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
-        {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data);
-        }
+        gfx_map_gx_data(_g1, file, static_cast<size_t>(fs.GetPosition()));
         return true;
     }
     catch (const std::exception&)
     {
+        _g1.data = nullptr;
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -239,21 +276,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    _g1.data = nullptr;
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    _g2.data = nullptr;
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    _csg.data = nullptr;
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -268,25 +305,20 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto file = std::make_shared<MemoryMappedFile>(path);
+        auto fs = MemoryStream(file->GetData(), file->GetLength());
         _g2.header = fs.ReadValue<rct_g1_header>();
 
         // Read element headers
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data);
-        }
+        gfx_map_gx_data(_g2, file, static_cast<size_t>(fs.GetPosition()));
         return true;
     }
     catch (const std::exception&)
     {
+        _g2.data = nullptr;
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -315,9 +347,9 @@ bool gfx_load_csg()
     try
     {
         auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileData = std::make_shared<MemoryMappedFile>(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = fileData->GetLength();
 
         _csg.header.num_entries = static_cast<uint32_t>(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = static_cast<uint32_t>(fileDataSize);
@@ -331,14 +363,10 @@ bool gfx_load_csg()
         // Read element headers
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
+        gfx_map_gx_data(_csg, fileData, 0);
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
-        // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data);
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -350,6 +378,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csg.data = nullptr;
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -649,6 +678,122 @@ void FASTCALL gfx_draw_sprite_raw_masked_software(
     mask_fn(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+/**
+ * Marks the list as drawn this frame and reads its pixel data if it is not loaded.
+ * @returns false if the pixel data could not be read.
+ */
+static bool gfx_use_lazy_images(LazyImageList& list)
+{
+    list.LastUsed.store(_lazyImageFrame, std::memory_order_relaxed);
+    if (!list.Loaded.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(_lazyImageMutex);
+        if (!list.Loaded.load(std::memory_order_relaxed) && !list.Failed)
+        {
+            auto images = list.Source->LoadImages();
+            if (images == nullptr)
+            {
+                list.Failed = true;
+            }
+            else
+            {
+                for (uint32_t i = 0; i < list.Count; i++)
+                {
+                    _imageListElements[list.BaseIndex + i].offset = images[i].offset;
+                }
+                _lazyImageLoadedSize += list.Source->GetImageDataSize();
+                list.Loaded.store(true, std::memory_order_release);
+            }
+        }
+        return !list.Failed;
+    }
+    return true;
+}
+
+static void gfx_unload_lazy_images(LazyImageList& list)
+{
+    for (uint32_t i = 0; i < list.Count; i++)
+    {
+        _imageListElements[list.BaseIndex + i].offset = nullptr;
+    }
+    _lazyImageLoadedSize -= list.Source->GetImageDataSize();
+    list.Source->UnloadImages();
+    list.Loaded = false;
+}
+
+void gfx_register_lazy_images(uint32_t baseImageId, uint32_t count, ILazyImageSource* source)
+{
+    auto slot = std::find(_lazyImageLists.begin(), _lazyImageLists.end(), nullptr);
+    if (slot == _lazyImageLists.end())
+    {
+        slot = _lazyImageLists.insert(slot, nullptr);
+    }
+    *slot = std::make_unique<LazyImageList>();
+    (*slot)->Source = source;
+    (*slot)->BaseIndex = baseImageId - SPR_IMAGE_LIST_BEGIN;
+    (*slot)->Count = count;
+    (*slot)->LastUsed = _lazyImageFrame;
+
+    auto index = static_cast<uint32_t>(std::distance(_lazyImageLists.begin(), slot) + 1);
+    auto end = (*slot)->BaseIndex + count;
+    if (_imageListLazyIndex.size() < end)
+    {
+        _imageListLazyIndex.resize(std::max(end, _imageListElements.size()));
+    }
+    std::fill_n(_imageListLazyIndex.begin() + (*slot)->BaseIndex, count, index);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        _imageListElements[(*slot)->BaseIndex + i].offset = nullptr;
+    }
+}
+
+void gfx_unregister_lazy_images(uint32_t baseImageId, uint32_t count)
+{
+    auto baseIndex = static_cast<size_t>(baseImageId - SPR_IMAGE_LIST_BEGIN);
+    if (baseIndex < _imageListLazyIndex.size() && _imageListLazyIndex[baseIndex] != 0)
+    {
+        auto& slot = _lazyImageLists[_imageListLazyIndex[baseIndex] - 1];
+        if (slot->Loaded)
+        {
+            gfx_unload_lazy_images(*slot);
+        }
+        slot = nullptr;
+        auto length = std::min<size_t>(count, _imageListLazyIndex.size() - baseIndex);
+        std::fill_n(_imageListLazyIndex.begin() + baseIndex, length, 0);
+    }
+}
+
+void gfx_trim_lazy_images()
+{
+    // Evict the least recently drawn image lists until the loaded pixel data fits the budget again, lists drawn in the
+    // frame that just finished are kept.
+    auto budget = static_cast<size_t>(std::max(gConfigGeneral.lazy_image_budget, 0)) * 1024 * 1024;
+    if (_lazyImageLoadedSize > budget)
+    {
+        std::vector<LazyImageList*> candidates;
+        for (const auto& list : _lazyImageLists)
+        {
+            if (list != nullptr && list->Loaded && list->LastUsed != _lazyImageFrame)
+            {
+                candidates.push_back(list.get());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const LazyImageList* a, const LazyImageList* b) {
+            return a->LastUsed < b->LastUsed;
+        });
+        for (auto list : candidates)
+        {
+            if (_lazyImageLoadedSize <= budget)
+            {
+                break;
+            }
+            gfx_unload_lazy_images(*list);
+        }
+    }
+    _lazyImageFrame++;
+}
+
 const rct_g1_element* gfx_get_g1_element(ImageId imageId)
 {
     return gfx_get_g1_element(imageId.GetIndex());
@@ -706,6 +851,11 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
         size_t idx = offset - SPR_IMAGE_LIST_BEGIN;
         if (idx < _imageListElements.size())
         {
+            if (idx < _imageListLazyIndex.size() && _imageListLazyIndex[idx] != 0
+                && !gfx_use_lazy_images(*_lazyImageLists[_imageListLazyIndex[idx] - 1]))
+            {
+                return nullptr;
+            }
             return &_imageListElements[idx];
         }
     }
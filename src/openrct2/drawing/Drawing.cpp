@@ -13,6 +13,7 @@
 #include "../OpenRCT2.h"
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../interface/Viewport.h"
 #include "../object/Object.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -578,6 +579,44 @@ void mask_init()
     }
 }
 
+template<DrawBlendOp TBlendOp>
+static void blit_run_scalar_op(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
+const BlitRunFunctions blit_run_scalar = {
+    "scalar",
+    blit_run_scalar_op<BLEND_TRANSPARENT>,
+    blit_run_scalar_op<BLEND_TRANSPARENT | BLEND_SRC>,
+    blit_run_scalar_op<BLEND_TRANSPARENT | BLEND_DST>,
+    blit_run_scalar_op<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>,
+};
+
+BlitRunFunctions blit_run_fns = blit_run_scalar;
+
+void blit_run_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 run blitters");
+        blit_run_fns = blit_run_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 run blitters");
+        blit_run_fns = blit_run_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar run blitters");
+        blit_run_fns = blit_run_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo* dpi, const ScreenCoordsXY& coords, int32_t colour)
 {
     gfx_fill_rect(dpi, { coords, coords }, colour);
@@ -663,6 +702,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    viewports_invalidate_cache();
     gfx_set_dirty_blocks({ { 0, 0 }, { context_get_width(), context_get_height() } });
 }
 
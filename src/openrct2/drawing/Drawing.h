@@ -16,6 +16,7 @@
 #include "../world/Location.hpp"
 #include "Text.h"
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -25,6 +26,7 @@ struct ScreenRect;
 namespace OpenRCT2
 {
     struct IPlatformEnvironment;
+    class MemoryMappedFile;
 }
 
 namespace OpenRCT2::Drawing
@@ -97,7 +99,23 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    void* data;
+    // The element offsets point into this read-only mapping, the image data must never be written to.
+    std::shared_ptr<OpenRCT2::MemoryMappedFile> data;
+};
+
+/**
+ * An image table that only reads its pixel data once one of its images is requested from gfx_get_g1_element.
+ */
+struct ILazyImageSource
+{
+    virtual ~ILazyImageSource() = default;
+
+    /**
+     * Reads the pixel data and returns the images with their offsets set, or nullptr if the data can not be read.
+     */
+    virtual const rct_g1_element* LoadImages() abstract;
+    virtual void UnloadImages() abstract;
+    virtual size_t GetImageDataSize() const abstract;
 };
 
 struct rct_drawpixelinfo
@@ -527,6 +545,16 @@ public:
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
+
+    // Raw access for the run blitters, which do the same bounds check as operator[] themselves.
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+    uint32_t GetLength() const
+    {
+        return _dataLength;
+    }
 };
 
 struct DrawSpriteArgs
@@ -629,6 +657,74 @@ void FASTCALL BlitPixels(const uint8_t* src, uint8_t* dst, const PaletteMap& pal
     }
 }
 
+/**
+ * The pixel BlitPixel writes for a non-zero source pixel, looked up without going through PaletteMap. A result of zero
+ * leaves the destination untouched.
+ */
+template<DrawBlendOp TBlendOp> inline uint8_t BlitPixelValue(const uint8_t* map, uint32_t mapLength, uint8_t src, uint8_t dst)
+{
+    size_t index;
+    if constexpr (((TBlendOp & BLEND_SRC) != 0) && ((TBlendOp & BLEND_DST) != 0))
+    {
+        if (src == 0)
+        {
+            return 0;
+        }
+        index = ((src - 1) * 256) + dst;
+    }
+    else if constexpr ((TBlendOp & BLEND_SRC) != 0)
+    {
+        index = src;
+    }
+    else if constexpr ((TBlendOp & BLEND_DST) != 0)
+    {
+        index = dst;
+    }
+    else
+    {
+        return src;
+    }
+    return index < mapLength ? map[index] : 0;
+}
+
+/**
+ * Draws a run of count source pixels onto a single destination row, skipping transparent pixels like BlitPixel does.
+ */
+using BlitRunFunc = void (*)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap);
+
+/**
+ * One blitter for each blend mode RLE sprites are drawn with, all of them include BLEND_TRANSPARENT.
+ */
+struct BlitRunFunctions
+{
+    const char* Name;
+    BlitRunFunc Copy;
+    BlitRunFunc Remap;
+    BlitRunFunc Filter;
+    BlitRunFunc Blend;
+
+    template<DrawBlendOp TBlendOp> BlitRunFunc Get() const
+    {
+        static_assert((TBlendOp & BLEND_TRANSPARENT) != 0);
+        if constexpr (((TBlendOp & BLEND_SRC) != 0) && ((TBlendOp & BLEND_DST) != 0))
+        {
+            return Blend;
+        }
+        else if constexpr ((TBlendOp & BLEND_SRC) != 0)
+        {
+            return Remap;
+        }
+        else if constexpr ((TBlendOp & BLEND_DST) != 0)
+        {
+            return Filter;
+        }
+        else
+        {
+            return Copy;
+        }
+    }
+};
+
 #define SPRITE_ID_PALETTE_COLOUR_1(colourId) (IMAGE_TYPE_REMAP | ((colourId) << 19))
 #define SPRITE_ID_PALETTE_COLOUR_2(primaryId, secondaryId)                                                                     \
     (IMAGE_TYPE_REMAP_2_PLUS | IMAGE_TYPE_REMAP | (((primaryId) << 19) | ((secondaryId) << 24)))
@@ -711,7 +807,11 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id);
 void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1);
 bool is_csg_loaded();
 uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count);
+uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count, ILazyImageSource* lazySource);
 void gfx_object_free_images(uint32_t baseImageId, uint32_t count);
+void gfx_register_lazy_images(uint32_t baseImageId, uint32_t count, ILazyImageSource* source);
+void gfx_unregister_lazy_images(uint32_t baseImageId, uint32_t count);
+void gfx_trim_lazy_images();
 void gfx_object_check_all_images_freed();
 size_t ImageListGetUsedCount();
 size_t ImageListGetMaximum();
@@ -792,6 +892,12 @@ extern void (*mask_fn)(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+extern const BlitRunFunctions blit_run_scalar;
+extern const BlitRunFunctions blit_run_sse4_1;
+extern const BlitRunFunctions blit_run_avx2;
+extern BlitRunFunctions blit_run_fns;
+void blit_run_init();
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 
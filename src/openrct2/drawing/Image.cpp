@@ -212,10 +212,22 @@ uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count
     return baseImageId;
 }
 
+uint32_t gfx_object_allocate_images(const rct_g1_element* images, uint32_t count, ILazyImageSource* lazySource)
+{
+    auto baseImageId = gfx_object_allocate_images(images, count);
+    if (lazySource != nullptr && baseImageId != INVALID_IMAGE_ID)
+    {
+        gfx_register_lazy_images(baseImageId, count, lazySource);
+    }
+    return baseImageId;
+}
+
 void gfx_object_free_images(uint32_t baseImageId, uint32_t count)
 {
     if (baseImageId != 0 && baseImageId != INVALID_IMAGE_ID)
     {
+        gfx_unregister_lazy_images(baseImageId, count);
+
         // Zero the G1 elements so we don't have invalid pointers
         // and data lying about
         for (uint32_t i = 0; i < count; i++)
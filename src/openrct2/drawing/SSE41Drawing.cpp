@@ -56,6 +56,40 @@ void mask_sse4_1(
     }
 }
 
+template<DrawBlendOp TBlendOp>
+static void blit_run_sse4_1_op(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    const uint8_t* map = paletteMap.GetData();
+    const uint32_t mapLength = paletteMap.GetLength();
+    const __m128i zero = {};
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i pixels = source;
+        __m128i skip = _mm_cmpeq_epi8(source, zero);
+        if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) != 0)
+        {
+            // There is no byte gather, so the palette lookups stay scalar but the transparency tests and the writes to
+            // the destination are done for the whole block at once.
+            alignas(16) uint8_t mapped[16];
+            for (int32_t j = 0; j < 16; j++)
+            {
+                mapped[j] = BlitPixelValue<TBlendOp>(map, mapLength, src[i + j], dst[i + j]);
+            }
+            pixels = _mm_load_si128(reinterpret_cast<const __m128i*>(mapped));
+            skip = _mm_or_si128(skip, _mm_cmpeq_epi8(pixels, zero));
+        }
+        // _mm_blendv_epi8 is SSE4.1
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, skip));
+    }
+    for (; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +103,18 @@ void mask_sse4_1(
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+template<DrawBlendOp TBlendOp>
+static void blit_run_sse4_1_op(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
+
+const BlitRunFunctions blit_run_sse4_1 = {
+    "sse4.1",
+    blit_run_sse4_1_op<BLEND_TRANSPARENT>,
+    blit_run_sse4_1_op<BLEND_TRANSPARENT | BLEND_SRC>,
+    blit_run_sse4_1_op<BLEND_TRANSPARENT | BLEND_DST>,
+    blit_run_sse4_1_op<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>,
+};
@@ -15,6 +15,7 @@
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../ReplayManager.h"
+#include "../TickProfiler.h"
 #include "../Version.h"
 #include "../actions/ClimateSetAction.hpp"
 #include "../actions/RideSetPriceAction.hpp"
@@ -677,6 +678,14 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("render_weather_gloom %d", gConfigGeneral.render_weather_gloom);
         }
+        else if (argv[0] == "cache_viewports")
+        {
+            console.WriteFormatLine("cache_viewports %d", gConfigGeneral.cache_viewports);
+        }
+        else if (argv[0] == "cached_pathfinding")
+        {
+            console.WriteFormatLine("cached_pathfinding %d", gConfigGeneral.cached_pathfinding);
+        }
         else if (argv[0] == "cheat_sandbox_mode")
         {
             console.WriteFormatLine("cheat_sandbox_mode %d", gCheatsSandboxMode);
@@ -942,6 +951,19 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             config_save_default();
             console.Execute("get render_weather_gloom");
         }
+        else if (argv[0] == "cache_viewports" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gConfigGeneral.cache_viewports = (int_val[0] != 0);
+            config_save_default();
+            gfx_invalidate_screen();
+            console.Execute("get cache_viewports");
+        }
+        else if (argv[0] == "cached_pathfinding" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gConfigGeneral.cached_pathfinding = (int_val[0] != 0);
+            config_save_default();
+            console.Execute("get cached_pathfinding");
+        }
         else if (argv[0] == "cheat_sandbox_mode" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             if (gCheatsSandboxMode != (int_val[0] != 0))
@@ -1261,6 +1283,73 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static int32_t cc_profiler(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty())
+    {
+        if (argv[0] == "start")
+        {
+            TickProfiler::SetEnabled(true);
+            console.WriteLine("Tick profiler started.");
+            return 0;
+        }
+        if (argv[0] == "stop")
+        {
+            TickProfiler::SetEnabled(false);
+            console.WriteLine("Tick profiler stopped.");
+            return 0;
+        }
+        if (argv[0] == "reset")
+        {
+            TickProfiler::Reset();
+            GameActions::ResetQueueStats();
+            console.WriteLine("Tick profiler reset.");
+            return 0;
+        }
+        if (argv[0] != "show")
+        {
+            console.WriteFormatLine("Unknown subcommand: %s", argv[0].c_str());
+            return 1;
+        }
+    }
+
+    console.WriteFormatLine(
+        "Tick profiler %s, %llu ticks recorded (times in microseconds):",
+        TickProfiler::IsEnabled() ? "running" : "stopped", static_cast<unsigned long long>(TickProfiler::GetTickCount()));
+    console.WriteFormatLine("%-18s %10s %10s %10s %10s", "stage", "mean", "p50", "p99", "max");
+    for (const auto& stats : TickProfiler::GetStageStats())
+    {
+        console.WriteFormatLine("%-18s %10.1f %10.1f %10.1f %10.1f", stats.Name, stats.Mean, stats.P50, stats.P99, stats.Max);
+    }
+    for (const auto& entityCount : TickProfiler::GetEntityCounts())
+    {
+        console.WriteFormatLine("%-18s %10u", entityCount.Name, entityCount.Count);
+    }
+
+    auto queueStats = GameActions::GetQueueStats();
+    if (!queueStats.empty())
+    {
+        console.WriteFormatLine("Queued game actions, peak queue depth %zu:", GameActions::GetQueuePeakDepth());
+        console.WriteFormatLine("%-28s %8s %10s %10s %10s %10s", "action", "count", "wait", "max wait", "execute", "max exec");
+        for (const auto& stats : queueStats)
+        {
+            console.WriteFormatLine(
+                "%-28s %8llu %10.1f %10.1f %10.1f %10.1f", stats.Name, static_cast<unsigned long long>(stats.Count),
+                stats.MeanWait, stats.MaxWait, stats.MeanExecute, stats.MaxExecute);
+        }
+    }
+
+    auto networkStats = network_get_stats();
+    if (networkStats.mapsSent != 0)
+    {
+        console.WriteFormatLine(
+            "Maps sent to joining clients: %u, main thread stall mean %.1f, max %llu", networkStats.mapsSent,
+            static_cast<double>(networkStats.mapStallTotal) / networkStats.mapsSent,
+            static_cast<unsigned long long>(networkStats.mapStallMax));
+    }
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1750,6 +1839,8 @@ static constexpr const utf8* console_variable_table[] = {
     "window_limit",
     "render_weather_effects",
     "render_weather_gloom",
+    "cache_viewports",
+    "cached_pathfinding",
     "cheat_sandbox_mode",
     "cheat_disable_clearance_checks",
     "cheat_disable_support_limits",
@@ -1785,6 +1876,7 @@ static constexpr const console_command console_command_table[] = {
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "profiler", cc_profiler, "Times each stage of the game logic update.", "profiler [start|stop|reset|show]" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
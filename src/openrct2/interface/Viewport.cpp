@@ -18,6 +18,7 @@
 #include "../core/JobPool.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
+#include "../drawing/LightFX.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -32,6 +33,7 @@
 #include "Window_internal.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
 using namespace OpenRCT2;
@@ -46,6 +48,64 @@ rct_viewport* g_music_tracking_viewport;
 
 static std::unique_ptr<JobPool> _paintJobs;
 
+/**
+ * The rasterised pixels of a viewport, so that regions which have not been invalidated through viewport_invalidate can
+ * be copied back rather than painted again. Blocks are addressed by absolute view pixel and stored in a wrap-around
+ * buffer, scrolling only paints the blocks that come into view.
+ */
+struct ViewportPixelCache
+{
+    static constexpr int32_t BlockShift = 6;
+    static constexpr int32_t BlockSize = 1 << BlockShift;
+    static constexpr ScreenCoordsXY EmptyBlock = { INT32_MIN, INT32_MIN };
+
+    std::vector<uint8_t> Pixels;
+    // The block held by each slot, EmptyBlock if the slot has to be painted.
+    std::vector<ScreenCoordsXY> Blocks;
+    int32_t Columns{};
+    int32_t Rows{};
+    ZoomLevel Zoom{};
+    uint32_t Flags{};
+    uint8_t Rotation{};
+
+    int32_t GetStride() const
+    {
+        return Columns * BlockSize;
+    }
+
+    int32_t GetColumn(int32_t blockX) const
+    {
+        return ((blockX % Columns) + Columns) % Columns;
+    }
+
+    int32_t GetRow(int32_t blockY) const
+    {
+        return ((blockY % Rows) + Rows) % Rows;
+    }
+
+    size_t GetSlot(int32_t blockX, int32_t blockY) const
+    {
+        return static_cast<size_t>(GetRow(blockY) * Columns + GetColumn(blockX));
+    }
+
+    uint8_t* GetPixels(int32_t x, int32_t y)
+    {
+        auto column = GetColumn(x >> BlockShift);
+        auto row = GetRow(y >> BlockShift);
+        auto offset = ((row << BlockShift) + (y & (BlockSize - 1))) * GetStride() + (column << BlockShift)
+            + (x & (BlockSize - 1));
+        return Pixels.data() + offset;
+    }
+
+    bool IsValid(int32_t blockX, int32_t blockY) const
+    {
+        const auto& block = Blocks[GetSlot(blockX, blockY)];
+        return block.x == blockX && block.y == blockY;
+    }
+};
+
+static std::array<ViewportPixelCache, MAX_VIEWPORT_COUNT> _viewportCaches;
+
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -155,6 +215,8 @@ void viewport_create(
         return;
     }
 
+    _viewportCaches[viewport - g_viewport_list] = {};
+
     viewport->pos = screenCoords;
     viewport->width = width;
     viewport->height = height;
@@ -779,6 +841,227 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
     window->viewport_target_sprite = window->viewport_focus_sprite.sprite_id;
 }
 
+static ViewportPixelCache* viewport_find_cache(const rct_viewport* viewport)
+{
+    if (viewport < g_viewport_list || viewport >= g_viewport_list + MAX_VIEWPORT_COUNT)
+        return nullptr;
+    return &_viewportCaches[viewport - g_viewport_list];
+}
+
+/**
+ * Returns the pixel cache to render the viewport through, or nullptr if the viewport has to be painted directly.
+ */
+static ViewportPixelCache* viewport_get_cache(const rct_viewport* viewport)
+{
+    auto cache = viewport_find_cache(viewport);
+    if (cache == nullptr)
+        return nullptr;
+
+    // The cache relies on the screen keeping its pixels between frames and on whole view pixels.
+    bool enabled = gConfigGeneral.cache_viewports && viewport->zoom >= 0 && drawing_engine_has_dirty_optimisations();
+#ifdef __ENABLE_LIGHTFX__
+    // Lights are collected while painting, cached regions would not emit them.
+    enabled = enabled && !lightfx_is_available();
+#endif
+    if (!enabled)
+    {
+        if (!cache->Pixels.empty())
+        {
+            *cache = {};
+        }
+        return nullptr;
+    }
+    return cache;
+}
+
+static void viewport_cache_configure(ViewportPixelCache& cache, const rct_viewport* viewport)
+{
+    auto columns = (viewport->width + ViewportPixelCache::BlockSize - 1) / ViewportPixelCache::BlockSize + 1;
+    auto rows = (viewport->height + ViewportPixelCache::BlockSize - 1) / ViewportPixelCache::BlockSize + 1;
+    auto rotation = get_current_rotation();
+    if (columns <= cache.Columns && rows <= cache.Rows && cache.Zoom == viewport->zoom && cache.Flags == viewport->flags
+        && cache.Rotation == rotation)
+    {
+        return;
+    }
+
+    cache.Columns = std::max(columns, cache.Columns);
+    cache.Rows = std::max(rows, cache.Rows);
+    cache.Zoom = viewport->zoom;
+    cache.Flags = viewport->flags;
+    cache.Rotation = rotation;
+    cache.Pixels.resize(static_cast<size_t>(cache.GetStride()) * (cache.Rows * ViewportPixelCache::BlockSize));
+    cache.Blocks.assign(static_cast<size_t>(cache.Columns) * cache.Rows, ViewportPixelCache::EmptyBlock);
+}
+
+/**
+ * Paints a rectangle of blocks, given inclusively in block coordinates, into the cache. The blocks must not wrap around
+ * the edges of the buffer.
+ */
+static void viewport_cache_paint(
+    ViewportPixelCache& cache, const rct_viewport* viewport, const rct_drawpixelinfo* dpi, const ScreenCoordsXY& topLeft,
+    const ScreenCoordsXY& bottomRight)
+{
+    auto left = topLeft.x * ViewportPixelCache::BlockSize;
+    auto top = topLeft.y * ViewportPixelCache::BlockSize;
+    auto width = (bottomRight.x - topLeft.x + 1) * ViewportPixelCache::BlockSize;
+    auto height = (bottomRight.y - topLeft.y + 1) * ViewportPixelCache::BlockSize;
+
+    rct_drawpixelinfo cacheDPI = *dpi;
+    cacheDPI.bits = cache.GetPixels(left, top);
+    cacheDPI.x = 0;
+    cacheDPI.y = 0;
+    cacheDPI.width = width;
+    cacheDPI.height = height;
+    cacheDPI.pitch = cache.GetStride() - width;
+    cacheDPI.zoom_level = 0;
+    cacheDPI.remX = 0;
+    cacheDPI.remY = 0;
+
+    // A viewport placed at the origin of the painted rectangle
+    rct_viewport cacheViewport = *viewport;
+    cacheViewport.pos = { 0, 0 };
+    cacheViewport.viewPos = { left * viewport->zoom, top * viewport->zoom };
+    viewport_paint(
+        &cacheViewport, &cacheDPI, cacheViewport.viewPos.x, cacheViewport.viewPos.y,
+        cacheViewport.viewPos.x + width * viewport->zoom, cacheViewport.viewPos.y + height * viewport->zoom);
+
+    for (auto y = topLeft.y; y <= bottomRight.y; y++)
+    {
+        for (auto x = topLeft.x; x <= bottomRight.x; x++)
+        {
+            cache.Blocks[cache.GetSlot(x, y)] = { x, y };
+        }
+    }
+}
+
+/**
+ * Paints every missing block within the given block coordinates, merging neighbouring blocks into rectangles to limit
+ * the number of paint sessions.
+ */
+static void viewport_cache_fill(
+    ViewportPixelCache& cache, const rct_viewport* viewport, const rct_drawpixelinfo* dpi, const ScreenCoordsXY& topLeft,
+    const ScreenCoordsXY& bottomRight)
+{
+    for (auto y = topLeft.y; y <= bottomRight.y; y++)
+    {
+        for (auto x = topLeft.x; x <= bottomRight.x; x++)
+        {
+            if (cache.IsValid(x, y))
+                continue;
+
+            auto right = x;
+            while (right < bottomRight.x && cache.GetColumn(right + 1) != 0 && !cache.IsValid(right + 1, y))
+            {
+                right++;
+            }
+
+            auto bottom = y;
+            while (bottom < bottomRight.y && cache.GetRow(bottom + 1) != 0)
+            {
+                bool missing = true;
+                for (auto xx = x; xx <= right && missing; xx++)
+                {
+                    missing = !cache.IsValid(xx, bottom + 1);
+                }
+                if (!missing)
+                    break;
+                bottom++;
+            }
+
+            viewport_cache_paint(cache, viewport, dpi, { x, y }, { right, bottom });
+            x = right;
+        }
+    }
+}
+
+/**
+ * Draws a region of the viewport, relative to the viewport position, by copying it out of the cache after painting any
+ * blocks that are missing.
+ */
+static void viewport_cache_render(
+    ViewportPixelCache& cache, const rct_viewport* viewport, rct_drawpixelinfo* dpi, int32_t left, int32_t top, int32_t right,
+    int32_t bottom)
+{
+    viewport_cache_configure(cache, viewport);
+
+    // Screen position of view pixel 0, 0
+    auto originX = viewport->pos.x - viewport->viewPos.x / viewport->zoom;
+    auto originY = viewport->pos.y - viewport->viewPos.y / viewport->zoom;
+
+    left = std::max<int32_t>(left + viewport->pos.x, dpi->x) - originX;
+    top = std::max<int32_t>(top + viewport->pos.y, dpi->y) - originY;
+    right = std::min<int32_t>(right + viewport->pos.x, dpi->x + dpi->width) - originX;
+    bottom = std::min<int32_t>(bottom + viewport->pos.y, dpi->y + dpi->height) - originY;
+    if (left >= right || top >= bottom)
+        return;
+
+    viewport_cache_fill(
+        cache, viewport, dpi, { left >> ViewportPixelCache::BlockShift, top >> ViewportPixelCache::BlockShift },
+        { (right - 1) >> ViewportPixelCache::BlockShift, (bottom - 1) >> ViewportPixelCache::BlockShift });
+
+    auto stride = dpi->width + dpi->pitch;
+    for (auto y = top; y < bottom; y++)
+    {
+        auto dst = dpi->bits + (left + originX - dpi->x) + (y + originY - dpi->y) * stride;
+        for (auto x = left; x < right;)
+        {
+            auto blockEnd = ((x >> ViewportPixelCache::BlockShift) + 1) * ViewportPixelCache::BlockSize;
+            auto count = std::min(right, blockEnd) - x;
+            std::memcpy(dst, cache.GetPixels(x, y), count);
+            dst += count;
+            x += count;
+        }
+    }
+}
+
+/**
+ * Left, top, right and bottom represent 2D map coordinates at zoom 0.
+ */
+static void viewport_cache_invalidate(const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    auto cache = viewport_find_cache(viewport);
+    if (cache == nullptr || cache->Blocks.empty())
+        return;
+
+    auto blockLeft = (left / cache->Zoom) >> ViewportPixelCache::BlockShift;
+    auto blockTop = (top / cache->Zoom) >> ViewportPixelCache::BlockShift;
+    auto blockRight = (right / cache->Zoom) >> ViewportPixelCache::BlockShift;
+    auto blockBottom = (bottom / cache->Zoom) >> ViewportPixelCache::BlockShift;
+
+    // Any slot that can hold a block of the region is visited once, even if the region is larger than the cache.
+    auto columns = std::min(blockRight - blockLeft + 1, cache->Columns);
+    auto rows = std::min(blockBottom - blockTop + 1, cache->Rows);
+    for (auto y = blockTop; y < blockTop + rows; y++)
+    {
+        for (auto x = blockLeft; x < blockLeft + columns; x++)
+        {
+            auto& block = cache->Blocks[cache->GetSlot(x, y)];
+            if (block.x >= blockLeft && block.x <= blockRight && block.y >= blockTop && block.y <= blockBottom)
+            {
+                block = ViewportPixelCache::EmptyBlock;
+            }
+        }
+    }
+}
+
+void viewport_invalidate_cache(const rct_viewport* viewport)
+{
+    auto cache = viewport_find_cache(viewport);
+    if (cache != nullptr)
+    {
+        std::fill(cache->Blocks.begin(), cache->Blocks.end(), ViewportPixelCache::EmptyBlock);
+    }
+}
+
+void viewports_invalidate_cache()
+{
+    for (auto& cache : _viewportCaches)
+    {
+        std::fill(cache.Blocks.begin(), cache.Blocks.end(), ViewportPixelCache::EmptyBlock);
+    }
+}
+
 /**
  *
  *  rct2: 0x00685C02
@@ -791,7 +1074,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     if (right <= viewport->pos.x)
         return;
@@ -811,17 +1094,25 @@ void viewport_render(
     top = std::max<int32_t>(top - viewport->pos.y, 0);
     bottom = std::min<int32_t>(bottom - viewport->pos.y, viewport->height);
 
-    left = left * viewport->zoom;
-    right = right * viewport->zoom;
-    top = top * viewport->zoom;
-    bottom = bottom * viewport->zoom;
+    auto cache = sessions == nullptr && dpi->zoom_level == 0 ? viewport_get_cache(viewport) : nullptr;
+    if (cache != nullptr)
+    {
+        viewport_cache_render(*cache, viewport, dpi, left, top, right, bottom);
+    }
+    else
+    {
+        left = left * viewport->zoom;
+        right = right * viewport->zoom;
+        top = top * viewport->zoom;
+        bottom = bottom * viewport->zoom;
 
-    left += viewport->viewPos.x;
-    right += viewport->viewPos.x;
-    top += viewport->viewPos.y;
-    bottom += viewport->viewPos.y;
+        left += viewport->viewPos.x;
+        right += viewport->viewPos.x;
+        top += viewport->viewPos.y;
+        bottom += viewport->viewPos.y;
 
-    viewport_paint(viewport, dpi, left, top, right, bottom, sessions);
+        viewport_paint(viewport, dpi, left, top, right, bottom, sessions);
+    }
 
 #ifdef DEBUG_SHOW_DIRTY_BOX
     if (viewport != g_viewport_list)
@@ -832,30 +1123,41 @@ void viewport_render(
 #endif
 }
 
-static void record_session(const paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void record_session(
+    const paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     // Perform a deep copy of the paint session, use relative offsets.
     // This is done to extract the session for benchmark.
     // Place the copied session at provided record_index, so the caller can decide which columns/paint sessions to copy; there
     // is no column information embedded in the session itself.
-    (*recorded_sessions)[record_index] = (*session);
-    paint_session* session_copy = &recorded_sessions->at(record_index);
+    auto& recordedSession = recorded_sessions->at(record_index);
+    recordedSession.Session = *session;
 
-    // Mind the offset needs to be calculated against the original `session`, not `session_copy`
-    for (auto& ps : session_copy->PaintStructs)
+    // Flatten the entry chunks, pointers become entry indices with the entry count meaning nullptr.
+    const auto& entries = session->PaintEntries;
+    const size_t entryCount = entries.GetCount();
+    recordedSession.Entries.resize(entryCount);
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        recordedSession.Entries[i] = entries[i];
+    }
+    auto toIndex = [&entries, entryCount](const paint_struct* ps) {
+        // Attached and string entries do not hold a valid next_quadrant_ps, those are treated as nullptr as well.
+        auto index = ps != nullptr ? entries.IndexOf(ps) : entryCount;
+        return reinterpret_cast<paint_struct*>(std::min(index, entryCount));
+    };
+    for (auto& ps : recordedSession.Entries)
     {
-        ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(
-            ps.basic.next_quadrant_ps ? int(ps.basic.next_quadrant_ps - &session->PaintStructs[0].basic)
-                                      : std::size(session->PaintStructs));
+        ps.basic.next_quadrant_ps = toIndex(ps.basic.next_quadrant_ps);
     }
-    for (auto& quad : session_copy->Quadrants)
+    for (auto& quad : recordedSession.Session.Quadrants)
     {
-        quad = reinterpret_cast<paint_struct*>(
-            quad ? int(quad - &session->PaintStructs[0].basic) : std::size(session->Quadrants));
+        quad = toIndex(quad);
     }
 }
 
-static void viewport_fill_column(paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void viewport_fill_column(
+    paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     paint_session_generate(session);
     if (recorded_sessions != nullptr)
@@ -908,7 +1210,7 @@ static void viewport_paint_column(paint_session* session)
  */
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* recorded_sessions)
+    std::vector<RecordedPaintSession>* recorded_sessions)
 {
     uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
@@ -992,12 +1294,7 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        if (useMultithreading)
-        {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
-        }
-        else
+        if (!useMultithreading)
         {
             viewport_fill_column(session, recorded_sessions, index);
         }
@@ -1005,7 +1302,8 @@ void viewport_paint(
 
     if (useMultithreading)
     {
-        _paintJobs->Join();
+        _paintJobs->ParallelFor(
+            columns.size(), [&columns, recorded_sessions](size_t i) { viewport_fill_column(columns[i], recorded_sessions, i); });
     }
 
     for (auto&& column : columns)
@@ -1014,6 +1312,11 @@ void viewport_paint(
     }
 }
 
+JobPool* viewport_get_paint_jobs()
+{
+    return _paintJobs.get();
+}
+
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
 {
     auto paletteId = climate_get_weather_gloom_palette_id(gClimateCurrent);
@@ -1690,6 +1993,9 @@ InteractionInfo get_map_coordinates_from_pos_window(rct_window* window, const Sc
  */
 void viewport_invalidate(rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
+    // The cache has to forget the region even if the viewport is not visible right now.
+    viewport_cache_invalidate(viewport, left, top, right, bottom);
+
     // if unknown viewport visibility, use the containing window to discover the status
     if (viewport->visibility == VisibilityCache::Unknown)
     {
@@ -518,6 +518,11 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
     if (widget->left == -2)
         return;
 
+    if (widget->type == WWT_VIEWPORT && w->viewport != nullptr)
+    {
+        viewport_invalidate_cache(w->viewport);
+    }
+
     gfx_set_dirty_blocks({ { w->windowPos + ScreenCoordsXY{ widget->left, widget->top } },
                            { w->windowPos + ScreenCoordsXY{ widget->right + 1, widget->bottom + 1 } } });
 }
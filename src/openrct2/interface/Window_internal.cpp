@@ -1,6 +1,7 @@
 #include "Window_internal.h"
 
 #include "../world/Sprite.h"
+#include "Viewport.h"
 
 void rct_window::SetLocation(const CoordsXYZ& coords)
 {
@@ -40,6 +41,10 @@ void rct_window::ScrollToViewport()
 
 void rct_window::Invalidate()
 {
+    if (viewport != nullptr)
+    {
+        viewport_invalidate_cache(viewport);
+    }
     gfx_set_dirty_blocks({ windowPos, windowPos + ScreenCoordsXY{ width, height } });
 }
 
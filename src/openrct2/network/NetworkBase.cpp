@@ -34,7 +34,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "0"
+#define NETWORK_STREAM_VERSION "2"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -44,6 +44,13 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// A resync compares the exported park in blocks of at least this size.
+static constexpr uint32_t RESYNC_BLOCK_SIZE = 4096;
+// Limits the block hashes of a resync request to a single packet.
+static constexpr uint32_t RESYNC_MAX_BLOCKS = 6000;
+// Minimum time in milliseconds between two resyncs sent to the same client, each one exports the whole park.
+static constexpr uint32_t RESYNC_MIN_INTERVAL = 5000;
+
 #ifndef DISABLE_NETWORK
 
 #    include "../Cheats.h"
@@ -80,9 +87,11 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include <algorithm>
 #    include <array>
 #    include <cerrno>
+#    include <chrono>
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
+#    include <future>
 #    include <list>
 #    include <map>
 #    include <memory>
@@ -126,6 +135,7 @@ NetworkBase::NetworkBase()
     client_command_handlers[NetworkCommand::ObjectsList] = &NetworkBase::Client_Handle_OBJECTS_LIST;
     client_command_handlers[NetworkCommand::Scripts] = &NetworkBase::Client_Handle_SCRIPTS;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::Resync] = &NetworkBase::Client_Handle_RESYNC;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::Server_Handle_AUTH;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::Server_Handle_CHAT;
@@ -135,6 +145,7 @@ NetworkBase::NetworkBase()
     server_command_handlers[NetworkCommand::Token] = &NetworkBase::Server_Handle_TOKEN;
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::Server_Handle_MAPREQUEST;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::Server_Handle_REQUEST_GAMESTATE;
+    server_command_handlers[NetworkCommand::RequestResync] = &NetworkBase::Server_Handle_REQUEST_RESYNC;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::Server_Handle_HEARTBEAT;
 
     _chat_log_fs << std::unitbuf;
@@ -228,8 +239,13 @@ void NetworkBase::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _socketPoller.reset();
         _listenSocket.reset();
         _advertiser.reset();
+        _mapSnapshot = {};
+        _mapsSent = 0;
+        _mapStallTotal = 0;
+        _mapStallMax = 0;
     }
 
     mode = NETWORK_MODE_NONE;
@@ -356,6 +372,8 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
     try
     {
         _listenSocket->Listen(address, port);
+        _socketPoller = CreateSocketPoller();
+        _socketPoller->Add(_listenSocket.get());
     }
     catch (const std::exception& ex)
     {
@@ -458,6 +476,7 @@ void NetworkBase::Update()
     uint32_t ticks = platform_get_ticks();
     _currentDeltaTime = std::max<uint32_t>(ticks - _lastUpdateTime, 1);
     _lastUpdateTime = ticks;
+    _updateCount++;
 
     switch (GetMode())
     {
@@ -496,21 +515,50 @@ void NetworkBase::Flush()
     }
 }
 
+void NetworkBase::WaitForData(uint32_t timeoutMs)
+{
+    if (GetMode() == NETWORK_MODE_SERVER && _socketPoller != nullptr)
+    {
+        // Service the clients as soon as they send something rather than on the next tick.
+        if (!_socketPoller->Wait(timeoutMs).empty())
+        {
+            Update();
+        }
+    }
+    else
+    {
+        platform_sleep(timeoutMs);
+    }
+}
+
 void NetworkBase::UpdateServer()
 {
+    // Only the sockets with pending data or connections are read from, idle clients just get their queued packets sent.
+    _readySockets = _socketPoller->Wait(0);
+    std::sort(_readySockets.begin(), _readySockets.end());
+    auto isReady = [this](const ITcpSocket* socket) {
+        return std::binary_search(_readySockets.begin(), _readySockets.end(), socket);
+    };
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
         if (connection->IsDisconnected)
             continue;
 
-        if (!ProcessConnection(*connection))
+        if (!ProcessConnection(*connection, isReady(connection->Socket.get())))
         {
             connection->IsDisconnected = true;
+            _socketPoller->Remove(connection->Socket.get());
         }
         else
         {
             DecayCooldown(connection->Player);
+            if (connection->PendingResync.has_value()
+                && platform_get_ticks() - connection->LastResyncTime >= RESYNC_MIN_INTERVAL)
+            {
+                Server_Send_RESYNC(*connection);
+            }
         }
     }
 
@@ -526,10 +574,13 @@ void NetworkBase::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (isReady(_listenSocket.get()))
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -716,6 +767,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd)
 {
+    // Serialised once on first use, every connection queues the same buffer.
+    std::shared_ptr<const NetworkPacketBuffer> buffer;
     for (auto& client_connection : client_connection_list)
     {
         if (client_connection->IsDisconnected)
@@ -735,8 +788,11 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        auto packetCopy = packet;
-        client_connection->QueuePacket(std::move(packetCopy), front);
+        if (buffer == nullptr)
+        {
+            buffer = NetworkConnection::SerialisePacket(packet);
+        }
+        client_connection->QueuePacket(buffer, front);
     }
 }
 
@@ -750,7 +806,7 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
     if (itTickData == std::end(_serverTickData))
         return true;
 
-    const ServerTickData_t storedTick = itTickData->second;
+    const ServerTickData_t storedTick = std::move(itTickData->second);
     _serverTickData.erase(itTickData);
 
     if (storedTick.srand0 != srand0)
@@ -761,11 +817,23 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum_root();
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
             log_info("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
+
+            // Report which entity slots hold the divergence.
+            const auto& groups = sprite_checksum_groups();
+            for (size_t i = 0; i < groups.size() && i < storedTick.spriteGroupHashes.size(); i++)
+            {
+                if (groups[i] != storedTick.spriteGroupHashes[i])
+                {
+                    auto first = i * SPRITE_CHECKSUM_GROUP_SIZE;
+                    auto last = std::min<size_t>(first + SPRITE_CHECKSUM_GROUP_SIZE, MAX_SPRITES) - 1;
+                    log_info("Sprites %zu to %zu differ from the server", first, last);
+                }
+            }
             return false;
         }
     }
@@ -798,6 +866,11 @@ bool NetworkBase::CheckDesynchronizaton()
         {
             Close();
         }
+        else
+        {
+            // Fetch the parts of the park that differ from the server rather than staying desynchronised.
+            Client_Send_REQUEST_RESYNC(false);
+        }
 
         return true;
     }
@@ -1339,6 +1412,9 @@ NetworkStats_t NetworkBase::GetStats() const
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
         }
+        stats.mapsSent = _mapsSent;
+        stats.mapStallTotal = _mapStallTotal;
+        stats.mapStallMax = _mapStallMax;
     }
     return stats;
 }
@@ -1365,6 +1441,8 @@ void NetworkBase::Server_Send_AUTH(NetworkConnection& connection)
 
 void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
 {
+    const auto startTime = std::chrono::steady_clock::now();
+
     std::vector<const ObjectRepositoryItem*> objects;
     if (connection)
     {
@@ -1378,53 +1456,66 @@ void NetworkBase::Server_Send_MAP(NetworkConnection* connection)
         auto& objManager = context->GetObjectManager();
         objects = objManager.GetPackableObjects();
     }
+    std::sort(objects.begin(), objects.end());
+    objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
 
-    auto header = save_for_network(objects);
-    if (header.empty())
+    // Clients joining during the same update get the same map, which is only exported and compressed once. Packing
+    // objects a client already has is harmless, so the snapshot is rebuilt with the union if a client needs more.
+    bool reuseSnapshot = connection != nullptr && _mapSnapshot.Packets.valid() && _mapSnapshot.Update == _updateCount;
+    if (reuseSnapshot
+        && !std::includes(_mapSnapshot.Objects.begin(), _mapSnapshot.Objects.end(), objects.begin(), objects.end()))
     {
-        if (connection)
-        {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
-        }
-        return;
+        std::vector<const ObjectRepositoryItem*> merged;
+        std::set_union(
+            _mapSnapshot.Objects.begin(), _mapSnapshot.Objects.end(), objects.begin(), objects.end(),
+            std::back_inserter(merged));
+        objects = std::move(merged);
+        reuseSnapshot = false;
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+
+    if (!reuseSnapshot)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
-        NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
-        if (connection)
+        auto packets = save_for_network(objects);
+        if (!packets.valid())
         {
-            connection->QueuePacket(std::move(packet));
+            if (connection)
+            {
+                connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+                connection->Socket->Disconnect();
+            }
+            return;
         }
-        else
+        _mapSnapshot = { _updateCount, std::move(objects), std::move(packets) };
+    }
+
+    if (connection)
+    {
+        connection->QueueDeferredPackets(_mapSnapshot.Packets);
+
+        auto stall = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        auto stallMicroseconds = static_cast<uint64_t>(stall.count());
+        _mapsSent++;
+        _mapStallTotal += stallMicroseconds;
+        _mapStallMax = std::max(_mapStallMax, stallMicroseconds);
+        log_verbose(
+            "Map for joining client %s in %.2f ms", reuseSnapshot ? "shared" : "exported", stallMicroseconds / 1000.0);
+    }
+    else
+    {
+        for (auto& client_connection : client_connection_list)
         {
-            SendPacketToClients(packet);
+            if (!client_connection->IsDisconnected)
+            {
+                client_connection->QueueDeferredPackets(_mapSnapshot.Packets);
+            }
         }
     }
 }
 
-std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
+static NetworkPacketBufferList CreateCompressedPackets(NetworkCommand command, const void* data, size_t size, int32_t level)
 {
     std::vector<uint8_t> header;
-    bool RLEState = gUseRLE;
-    gUseRLE = false;
-
-    auto ms = OpenRCT2::MemoryStream();
-    if (!SaveMap(&ms, objects))
-    {
-        log_warning("Failed to export map.");
-        return header;
-    }
-    gUseRLE = RLEState;
-
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
-
-    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
+    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size, level);
     if (compressed != std::nullopt)
     {
         std::string headerString = "open2_sv6_zlib";
@@ -1439,7 +1530,136 @@ std::vector<uint8_t> NetworkBase::save_for_network(const std::vector<const Objec
         header.resize(size);
         std::memcpy(header.data(), data, size);
     }
-    return header;
+
+    NetworkPacketBufferList packets;
+    for (size_t i = 0; i < header.size(); i += CHUNK_SIZE)
+    {
+        size_t datasize = std::min<size_t>(CHUNK_SIZE, header.size() - i);
+        NetworkPacket packet(command);
+        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
+        packet.Write(&header[i], datasize);
+        packets.push_back(NetworkConnection::SerialisePacket(packet));
+    }
+    return packets;
+}
+
+static int32_t GetMapCompressionLevel()
+{
+    return std::clamp(gConfigNetwork.map_compression_level, 0, 9);
+}
+
+std::shared_future<NetworkPacketBufferList> NetworkBase::save_for_network(
+    const std::vector<const ObjectRepositoryItem*>& objects) const
+{
+    auto ms = OpenRCT2::MemoryStream();
+    if (!SaveMap(&ms, objects))
+    {
+        log_warning("Failed to export map.");
+        return {};
+    }
+
+    // Only the export needs the game state, compressing and splitting into packets is left to a worker thread. The
+    // connections hold back anything queued after the map until it is ready.
+    auto task = [ms = std::move(ms), level = GetMapCompressionLevel()]() {
+        return CreateCompressedPackets(NetworkCommand::Map, ms.GetData(), static_cast<size_t>(ms.GetLength()), level);
+    };
+    return std::async(std::launch::async, std::move(task)).share();
+}
+
+static uint64_t HashResyncBlock(const uint8_t* data, size_t size)
+{
+    // FNV-1a, only has to tell apart the client's and the server's copy of the same block.
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::optional<std::vector<uint8_t>> NetworkBase::ExportForResync() const
+{
+    // Without packed objects the export has the same layout on both ends, so unchanged blocks line up.
+    auto ms = OpenRCT2::MemoryStream();
+    bool saved = SaveMap(&ms, {});
+    if (!saved)
+    {
+        log_warning("Failed to export map.");
+        return std::nullopt;
+    }
+
+    auto data = static_cast<const uint8_t*>(ms.GetData());
+    return std::vector<uint8_t>(data, data + ms.GetLength());
+}
+
+std::optional<std::vector<uint8_t>> NetworkBase::ApplyResync(const std::vector<uint8_t>& diff)
+{
+    auto map = std::move(_resyncBase);
+    _resyncBase = {};
+    try
+    {
+        auto ms = OpenRCT2::MemoryStream(diff.data(), diff.size());
+        auto size = ms.ReadValue<uint32_t>();
+        auto blockSize = ms.ReadValue<uint32_t>();
+        auto hash = ms.ReadValue<uint64_t>();
+        auto blockCount = ms.ReadValue<uint32_t>();
+        if (blockSize == 0)
+        {
+            return std::nullopt;
+        }
+
+        map.resize(size);
+        for (uint32_t i = 0; i < blockCount; i++)
+        {
+            auto offset = static_cast<size_t>(ms.ReadValue<uint32_t>()) * blockSize;
+            if (offset >= map.size())
+            {
+                return std::nullopt;
+            }
+            ms.Read(&map[offset], std::min<size_t>(blockSize, map.size() - offset));
+        }
+
+        if (HashResyncBlock(map.data(), map.size()) != hash)
+        {
+            return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+    return map;
+}
+
+void NetworkBase::Client_Send_REQUEST_RESYNC(bool full)
+{
+    // The server replies with the blocks of its park that differ from ours.
+    _resyncBase.clear();
+    if (!full)
+    {
+        auto data = ExportForResync();
+        if (data != std::nullopt)
+        {
+            _resyncBase = std::move(*data);
+        }
+    }
+
+    uint32_t blockSize = RESYNC_BLOCK_SIZE;
+    while (_resyncBase.size() / blockSize >= RESYNC_MAX_BLOCKS)
+    {
+        blockSize *= 2;
+    }
+    auto blockCount = static_cast<uint32_t>((_resyncBase.size() + blockSize - 1) / blockSize);
+    log_info("Requesting resync for tick %u, %u blocks of %u bytes", gCurrentTicks, blockCount, blockSize);
+
+    NetworkPacket packet(NetworkCommand::RequestResync);
+    packet << blockSize << blockCount;
+    for (size_t offset = 0; offset < _resyncBase.size(); offset += blockSize)
+    {
+        packet << HashResyncBlock(&_resyncBase[offset], std::min<size_t>(blockSize, _resyncBase.size() - offset));
+    }
+    _serverConnection->QueuePacket(std::move(packet));
 }
 
 void NetworkBase::Client_Send_CHAT(const char* text)
@@ -1525,8 +1745,15 @@ void NetworkBase::Server_Send_TICK()
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum_root();
         packet.WriteString(checksum.ToString().c_str());
+
+        const auto& groups = sprite_checksum_groups();
+        packet << static_cast<uint16_t>(groups.size());
+        for (auto groupHash : groups)
+        {
+            packet << groupHash;
+        }
     }
 
     SendPacketToClients(packet);
@@ -1659,10 +1886,10 @@ void NetworkBase::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName,
     SendPacketToClients(packet);
 }
 
-bool NetworkBase::ProcessConnection(NetworkConnection& connection)
+bool NetworkBase::ProcessConnection(NetworkConnection& connection, bool readable)
 {
-    NetworkReadPacket packetStatus;
-    do
+    NetworkReadPacket packetStatus = readable ? NetworkReadPacket::Success : NetworkReadPacket::NoData;
+    while (packetStatus == NetworkReadPacket::Success)
     {
         packetStatus = connection.ReadPacket();
         switch (packetStatus)
@@ -1689,7 +1916,7 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NetworkReadPacket::Success);
+    }
 
     connection.SendQueuedPackets();
 
@@ -1947,6 +2174,7 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    _socketPoller->Add(connection->Socket.get());
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2456,6 +2684,76 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
     }
 }
 
+void NetworkBase::Server_Handle_REQUEST_RESYNC(NetworkConnection& connection, NetworkPacket& packet)
+{
+    NetworkResyncRequest request;
+    uint32_t blockCount{};
+    packet >> request.BlockSize >> blockCount;
+    if (request.BlockSize < RESYNC_BLOCK_SIZE || blockCount > RESYNC_MAX_BLOCKS)
+    {
+        log_warning("Invalid resync request from %s", connection.Socket->GetHostName());
+        return;
+    }
+
+    request.BlockHashes.resize(blockCount);
+    for (auto& hash : request.BlockHashes)
+    {
+        packet >> hash;
+    }
+
+    // Only the latest request matters, anything sent too soon after the last resync is answered once the interval is
+    // up by UpdateServer.
+    connection.PendingResync = std::move(request);
+    if (connection.LastResyncTime == 0 || platform_get_ticks() - connection.LastResyncTime >= RESYNC_MIN_INTERVAL)
+    {
+        Server_Send_RESYNC(connection);
+    }
+}
+
+void NetworkBase::Server_Send_RESYNC(NetworkConnection& connection)
+{
+    auto request = std::move(*connection.PendingResync);
+    connection.PendingResync.reset();
+    connection.LastResyncTime = platform_get_ticks();
+
+    auto data = ExportForResync();
+    if (data == std::nullopt)
+    {
+        return;
+    }
+
+    // Only the export needs the game state, finding the changed blocks and compressing them is done on a worker thread.
+    auto task = [data = std::move(*data), hashes = std::move(request.BlockHashes), blockSize = request.BlockSize,
+                 level = GetMapCompressionLevel()]() {
+        auto ms = OpenRCT2::MemoryStream();
+        ms.WriteValue<uint32_t>(static_cast<uint32_t>(data.size()));
+        ms.WriteValue<uint32_t>(blockSize);
+        ms.WriteValue<uint64_t>(HashResyncBlock(data.data(), data.size()));
+
+        std::vector<uint32_t> changedBlocks;
+        for (size_t offset = 0, index = 0; offset < data.size(); offset += blockSize, index++)
+        {
+            auto length = std::min<size_t>(blockSize, data.size() - offset);
+            if (index >= hashes.size() || hashes[index] != HashResyncBlock(&data[offset], length))
+            {
+                changedBlocks.push_back(static_cast<uint32_t>(index));
+            }
+        }
+
+        ms.WriteValue<uint32_t>(static_cast<uint32_t>(changedBlocks.size()));
+        for (auto index : changedBlocks)
+        {
+            auto offset = static_cast<size_t>(index) * blockSize;
+            ms.WriteValue<uint32_t>(index);
+            ms.Write(&data[offset], std::min<size_t>(blockSize, data.size() - offset));
+        }
+        log_verbose("Resync of %u bytes, %u blocks changed", static_cast<uint32_t>(data.size()), changedBlocks.size());
+
+        return CreateCompressedPackets(NetworkCommand::Resync, ms.GetData(), static_cast<size_t>(ms.GetLength()), level);
+    };
+    connection.QueueDeferredPackets(std::async(std::launch::async, std::move(task)).share());
+}
+
 void NetworkBase::Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
@@ -2614,13 +2912,52 @@ void NetworkBase::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacke
 }
 
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    auto data = ReceiveMapChunk(packet);
+    if (data != std::nullopt)
+    {
+        LoadReceivedMap(*data);
+    }
+}
+
+void NetworkBase::Client_Handle_RESYNC([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    // Sent in chunks like the map, the patched park is then loaded as if it was downloaded.
+    bool fullResync = _resyncBase.empty();
+    auto data = ReceiveMapChunk(packet);
+    if (data == std::nullopt)
+    {
+        return;
+    }
+
+    auto map = ApplyResync(*data);
+    if (map == std::nullopt)
+    {
+        if (fullResync)
+        {
+            log_warning("Failed to resync with server.");
+            Close();
+        }
+        else
+        {
+            log_warning("Resync does not match the server, requesting the whole park.");
+            Client_Send_REQUEST_RESYNC(true);
+        }
+        return;
+    }
+
+    log_info("Resynchronised with server, %u bytes received", static_cast<uint32_t>(data->size()));
+    LoadReceivedMap(*map);
+}
+
+std::optional<std::vector<uint8_t>> NetworkBase::ReceiveMapChunk(NetworkPacket& packet)
 {
     uint32_t size, offset;
     packet >> size >> offset;
     int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
     if (chunksize <= 0)
     {
-        return;
+        return std::nullopt;
     }
     if (offset == 0)
     {
@@ -2649,66 +2986,66 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     context_open_intent(&intent);
 
     std::memcpy(&chunk_buffer[offset], const_cast<void*>(static_cast<const void*>(packet.Read(chunksize))), chunksize);
-    if (offset + chunksize == size)
+    if (offset + chunksize != size)
     {
-        // Allow queue processing of game actions again.
-        GameActions::ResumeQueue();
+        return std::nullopt;
+    }
 
-        context_force_close_window_by_class(WC_NETWORK_STATUS);
-        bool has_to_free = false;
-        uint8_t* data = &chunk_buffer[0];
-        size_t data_size = size;
-        // zlib-compressed
-        if (strcmp("open2_sv6_zlib", reinterpret_cast<char*>(&chunk_buffer[0])) == 0)
-        {
-            log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
-            {
-                log_warning("Failed to decompress data sent from server.");
-                Close();
-                return;
-            }
-        }
-        else
-        {
-            log_verbose("Assuming received map is in plain sv6 format");
-        }
+    // Allow queue processing of game actions again.
+    GameActions::ResumeQueue();
 
-        auto ms = MemoryStream(data, data_size);
-        if (LoadMap(&ms))
-        {
-            game_load_init();
-            game_load_scripts();
-            _serverState.tick = gCurrentTicks;
-            // window_network_status_open("Loaded new map from network");
-            _serverState.state = NetworkServerState::Ok;
-            _clientMapLoaded = true;
-            gFirstTimeSaving = true;
-
-            // Notify user he is now online and which shortcut key enables chat
-            network_chat_show_connected_message();
-
-            // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
-            fix_invalid_vehicle_sprite_sizes();
-
-            // NOTE: Game actions are normally processed before processing the player list.
-            // Given that during map load game actions are buffered we have to process the
-            // player list first to have valid players for the queued game actions.
-            ProcessPlayerList();
-        }
-        else
-        {
-            // Something went wrong, game is not loaded. Return to main screen.
-            auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PromptMode::SaveBeforeQuit);
-            GameActions::Execute(&loadOrQuitAction);
-        }
-        if (has_to_free)
+    context_force_close_window_by_class(WC_NETWORK_STATUS);
+    // zlib-compressed
+    if (strcmp("open2_sv6_zlib", reinterpret_cast<char*>(&chunk_buffer[0])) == 0)
+    {
+        log_verbose("Received zlib-compressed sv6 map");
+        size_t header_len = strlen("open2_sv6_zlib") + 1;
+        size_t data_size = 0;
+        uint8_t* data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
+        if (data == nullptr)
         {
-            free(data);
+            log_warning("Failed to decompress data sent from server.");
+            Close();
+            return std::nullopt;
         }
+        std::vector<uint8_t> result(data, data + data_size);
+        free(data);
+        return result;
+    }
+
+    log_verbose("Assuming received map is in plain sv6 format");
+    return std::vector<uint8_t>(chunk_buffer.begin(), chunk_buffer.begin() + size);
+}
+
+void NetworkBase::LoadReceivedMap(const std::vector<uint8_t>& data)
+{
+    auto ms = MemoryStream(data.data(), data.size());
+    if (LoadMap(&ms))
+    {
+        game_load_init();
+        game_load_scripts();
+        _serverState.tick = gCurrentTicks;
+        // window_network_status_open("Loaded new map from network");
+        _serverState.state = NetworkServerState::Ok;
+        _clientMapLoaded = true;
+        gFirstTimeSaving = true;
+
+        // Notify user he is now online and which shortcut key enables chat
+        network_chat_show_connected_message();
+
+        // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
+        fix_invalid_vehicle_sprite_sizes();
+
+        // NOTE: Game actions are normally processed before processing the player list.
+        // Given that during map load game actions are buffered we have to process the
+        // player list first to have valid players for the queued game actions.
+        ProcessPlayerList();
+    }
+    else
+    {
+        // Something went wrong, game is not loaded. Return to main screen.
+        auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PromptMode::SaveBeforeQuit);
+        GameActions::Execute(&loadOrQuitAction);
     }
 }
 
@@ -2776,6 +3113,7 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
     {
         auto s6exporter = std::make_unique<S6Exporter>();
         s6exporter->ExportObjectsList = objects;
+        s6exporter->UseRLE = false;
         s6exporter->Export();
         s6exporter->SaveGame(stream);
 
@@ -3017,6 +3355,14 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
         {
             tickData.spriteHash = text;
         }
+
+        uint16_t groupCount{};
+        packet >> groupCount;
+        tickData.spriteGroupHashes.resize(groupCount);
+        for (auto& groupHash : tickData.spriteGroupHashes)
+        {
+            packet >> groupHash;
+        }
     }
 
     // Don't let the history grow too much.
@@ -3242,6 +3588,11 @@ void network_flush()
     gNetwork.Flush();
 }
 
+void network_wait_for_data(uint32_t timeoutMs)
+{
+    gNetwork.WaitForData(timeoutMs);
+}
+
 int32_t network_get_mode()
 {
     return gNetwork.GetMode();
@@ -3990,6 +4341,10 @@ uint32_t network_get_server_tick()
 void network_flush()
 {
 }
+void network_wait_for_data(uint32_t timeoutMs)
+{
+    platform_sleep(timeoutMs);
+}
 void network_send_tick()
 {
 }
@@ -9,6 +9,7 @@
 #include "NetworkUser.h"
 
 #include <fstream>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -28,6 +29,7 @@ public: // Common
     uint32_t GetServerTick();
     void Update();
     void Flush();
+    void WaitForData(uint32_t timeoutMs);
     void ProcessPending();
     void ProcessPlayerList();
     std::vector<std::unique_ptr<NetworkPlayer>>::iterator GetPlayerIteratorByID(uint8_t id);
@@ -43,7 +45,7 @@ public: // Common
     void CloseChatLog();
     NetworkStats_t GetStats() const;
     json_t GetServerInfoAsJson() const;
-    bool ProcessConnection(NetworkConnection& connection);
+    bool ProcessConnection(NetworkConnection& connection, bool readable = true);
     void CloseConnection();
     NetworkPlayer* AddPlayer(const std::string& name, const std::string& keyhash);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
@@ -69,7 +71,9 @@ public: // Server
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::shared_future<NetworkPacketBufferList> save_for_network(
+        const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::optional<std::vector<uint8_t>> ExportForResync() const;
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
@@ -91,6 +95,7 @@ public: // Server
     void Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, const char* reason);
     void Server_Send_OBJECTS_LIST(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void Server_Send_SCRIPTS(NetworkConnection& connection) const;
+    void Server_Send_RESYNC(NetworkConnection& connection);
 
     // Handlers
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
@@ -103,6 +108,7 @@ public: // Server
     void Server_Handle_GAMEINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_MAPREQUEST(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_REQUEST_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
 
 public: // Client
     void Reconnect();
@@ -121,6 +127,9 @@ public: // Client
     NetworkServerState_t GetServerState() const;
     void ServerClientDisconnected();
     bool LoadMap(OpenRCT2::IStream* stream);
+    std::optional<std::vector<uint8_t>> ReceiveMapChunk(NetworkPacket& packet);
+    void LoadReceivedMap(const std::vector<uint8_t>& data);
+    std::optional<std::vector<uint8_t>> ApplyResync(const std::vector<uint8_t>& diff);
     void UpdateClient();
 
     // Packet dispatchers.
@@ -134,6 +143,7 @@ public: // Client
     void Client_Send_GAMEINFO();
     void Client_Send_MAPREQUEST(const std::vector<std::string>& objects);
     void Client_Send_HEARTBEAT(NetworkConnection& connection) const;
+    void Client_Send_REQUEST_RESYNC(bool full);
 
     // Handlers.
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
@@ -154,6 +164,7 @@ public: // Client
     void Client_Handle_OBJECTS_LIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -187,6 +198,9 @@ private: // Common Data
 private: // Server Data
     std::unordered_map<NetworkCommand, CommandHandler> server_command_handlers;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<ISocketPoller> _socketPoller;
+    std::vector<ITcpSocket*> _readySockets;
+    uint32_t _updateCount = 0;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::string _serverLogPath;
@@ -195,6 +209,18 @@ private: // Server Data
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
 
+    // The most recent map sent to joining clients, shared by all clients that join during the same update.
+    struct MapSnapshot
+    {
+        uint32_t Update = 0;
+        std::vector<const ObjectRepositoryItem*> Objects;
+        std::shared_future<NetworkPacketBufferList> Packets;
+    };
+    MapSnapshot _mapSnapshot;
+    uint32_t _mapsSent = 0;
+    uint64_t _mapStallTotal = 0;
+    uint64_t _mapStallMax = 0;
+
 private: // Client Data
     struct PlayerListUpdate
     {
@@ -206,6 +232,7 @@ private: // Client Data
         uint32_t srand0;
         uint32_t tick;
         std::string spriteHash;
+        std::vector<uint64_t> spriteGroupHashes;
     };
 
     std::unordered_map<NetworkCommand, CommandHandler> client_command_handlers;
@@ -219,6 +246,8 @@ private: // Client Data
     std::string _chatLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::string _password;
     OpenRCT2::MemoryStream _serverGameState;
+    // Our park as it was when a resync was requested, the server sends the blocks that differ from it.
+    std::vector<uint8_t> _resyncBase;
     NetworkServerState_t _serverState;
     uint32_t _lastSentHeartbeat = 0;
     uint32_t last_ping_sent_time = 0;
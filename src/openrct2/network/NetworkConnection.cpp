@@ -17,6 +17,9 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <array>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
 
@@ -89,7 +92,7 @@ NetworkReadPacket NetworkConnection::ReadPacket()
             // Received complete packet.
             _lastPacketTime = platform_get_ticks();
 
-            RecordPacketStats(InboundPacket, false);
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
 
             return NetworkReadPacket::Success;
         }
@@ -98,42 +101,37 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+std::shared_ptr<const NetworkPacketBuffer> NetworkConnection::SerialisePacket(const NetworkPacket& packet)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
+    auto buffer = std::make_shared<NetworkPacketBuffer>();
+    buffer->Command = packet.GetCommand();
 
+    PacketHeader header{};
     // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
     // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
+    header.Size = static_cast<uint16_t>(packet.Data.size() + sizeof(header.Id));
     header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
-
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+    header.Id = ByteSwapBE(packet.GetCommand());
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
-    }
+    auto& bytes = buffer->Bytes;
+    bytes.reserve(sizeof(header) + packet.Data.size());
+    bytes.insert(bytes.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
+    bytes.insert(bytes.end(), packet.Data.begin(), packet.Data.end());
+    return buffer;
+}
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth(packet.GetCommand()))
     {
-        RecordPacketStats(packet, true);
+        QueuePacket(SerialisePacket(packet), front);
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth(buffer->Command))
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
@@ -141,25 +139,93 @@ void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
             {
                 auto it = _outboundPackets.begin();
                 it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(it, { buffer });
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front({ buffer });
             }
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back({ buffer });
         }
     }
 }
 
+void NetworkConnection::QueueDeferredPackets(const std::shared_future<NetworkPacketBufferList>& packets)
+{
+    _outboundPackets.push_back({ nullptr, 0, packets });
+}
+
+bool NetworkConnection::ResolveDeferredPackets()
+{
+    auto& front = _outboundPackets.front();
+    if (front.Deferred.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return false;
+    }
+
+    auto packets = front.Deferred;
+    _outboundPackets.pop_front();
+    const auto& buffers = packets.get();
+    for (auto it = buffers.rbegin(); it != buffers.rend(); it++)
+    {
+        if (AuthStatus == NetworkAuth::Ok || !NetworkPacket::CommandRequiresAuth((*it)->Command))
+        {
+            _outboundPackets.push_front({ *it });
+        }
+    }
+    return true;
+}
+
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    while (!_outboundPackets.empty())
     {
-        _outboundPackets.pop_front();
+        if (_outboundPackets.front().Buffer == nullptr)
+        {
+            if (!ResolveDeferredPackets())
+                break;
+            continue;
+        }
+
+        // Hand as many queued packets as possible to the socket in one call.
+        std::array<SocketBuffer, MaxSocketBuffers> buffers;
+        size_t count = 0;
+        size_t total = 0;
+        for (const auto& packet : _outboundPackets)
+        {
+            if (count == buffers.size() || packet.Buffer == nullptr)
+                break;
+
+            const auto& bytes = packet.Buffer->Bytes;
+            buffers[count] = { bytes.data() + packet.BytesTransferred, bytes.size() - packet.BytesTransferred };
+            total += buffers[count].Size;
+            count++;
+        }
+
+        size_t sent = Socket->SendData(buffers.data(), count);
+        const bool sentAll = sent == total;
+        while (sent > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            const auto size = packet.Buffer->Bytes.size();
+            const auto transferred = std::min(sent, size - packet.BytesTransferred);
+            packet.BytesTransferred += transferred;
+            sent -= transferred;
+            if (packet.BytesTransferred == size)
+            {
+                RecordPacketStats(packet.Buffer->Command, size, true);
+                _outboundPackets.pop_front();
+            }
+        }
+
+        if (!sentAll)
+        {
+            // The socket can not take more data right now.
+            break;
+        }
     }
 }
 
@@ -207,17 +273,18 @@ void NetworkConnection::SetLastDisconnectReason(const rct_string_id string_id, v
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t size, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
+    uint32_t packetSize = static_cast<uint32_t>(size);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
             break;
         case NetworkCommand::Map:
+        case NetworkCommand::Resync:
             trafficGroup = NetworkStatisticsGroup::MapData;
             break;
         default:
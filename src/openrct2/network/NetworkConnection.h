@@ -17,12 +17,20 @@
 #    include "Socket.h"
 
 #    include <deque>
+#    include <future>
 #    include <memory>
+#    include <optional>
 #    include <vector>
 
 class NetworkPlayer;
 struct ObjectRepositoryItem;
 
+struct NetworkResyncRequest
+{
+    uint32_t BlockSize = 0;
+    std::vector<uint64_t> BlockHashes;
+};
+
 class NetworkConnection final
 {
 public:
@@ -36,17 +44,23 @@ public:
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool IsDisconnected = false;
+    // Resync requests are answered at most once per interval, a request arriving sooner waits here and replaces any
+    // earlier one that is still waiting.
+    std::optional<NetworkResyncRequest> PendingResync;
+    uint32_t LastResyncTime = 0;
 
     NetworkConnection();
     ~NetworkConnection();
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(const std::shared_ptr<const NetworkPacketBuffer>& buffer, bool front = false);
+
+    /**
+     * Queues packets that are still being prepared on another thread. Packets queued afterwards are held back until
+     * these have been sent.
+     */
+    void QueueDeferredPackets(const std::shared_future<NetworkPacketBufferList>& packets);
 
     void SendQueuedPackets();
     void ResetLastPacketTime();
@@ -56,13 +70,23 @@ public:
     void SetLastDisconnectReason(const utf8* src);
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
+    static std::shared_ptr<const NetworkPacketBuffer> SerialisePacket(const NetworkPacket& packet);
+
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    struct OutboundPacket
+    {
+        std::shared_ptr<const NetworkPacketBuffer> Buffer;
+        size_t BytesTransferred = 0;
+        // Set instead of Buffer for packets that are not ready yet.
+        std::shared_future<NetworkPacketBufferList> Deferred{};
+    };
+
+    std::deque<OutboundPacket> _outboundPackets;
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t size, bool sending);
+    bool ResolveDeferredPackets();
 };
 
 #endif // DISABLE_NETWORK
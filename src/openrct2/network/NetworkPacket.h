@@ -25,6 +25,17 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet in its wire format, header included. It is not modified once built, so a broadcast packet is serialised once
+ * and the same buffer is queued on every connection.
+ */
+struct NetworkPacketBuffer
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::vector<uint8_t> Bytes;
+};
+using NetworkPacketBufferList = std::vector<std::shared_ptr<const NetworkPacketBuffer>>;
+
 struct NetworkPacket final
 {
     NetworkPacket() = default;
@@ -37,6 +48,7 @@ struct NetworkPacket final
 
     void Clear();
     bool CommandRequiresAuth();
+    static bool CommandRequiresAuth(NetworkCommand command);
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
@@ -83,6 +83,8 @@ enum class NetworkCommand : uint32_t
     GameState,
     Scripts,
     Heartbeat,
+    RequestResync,
+    Resync,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -145,4 +147,8 @@ struct NetworkStats_t
 {
     uint64_t bytesReceived[EnumValue(NetworkStatisticsGroup::Max)];
     uint64_t bytesSent[EnumValue(NetworkStatisticsGroup::Max)];
+    // Time the server spent on the main thread preparing the map for joining clients, in microseconds.
+    uint32_t mapsSent;
+    uint64_t mapStallTotal;
+    uint64_t mapStallMax;
 };
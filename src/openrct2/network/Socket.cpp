@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -49,8 +50,10 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -59,6 +62,7 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -66,6 +70,7 @@
 #endif // _WIN32
 // clang-format on
 
+#    include "../platform/platform.h"
 #    include "Socket.h"
 
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
@@ -276,6 +281,11 @@ public:
         return _status;
     }
 
+    SOCKET GetHandle() const
+    {
+        return _socket;
+    }
+
     const char* GetError() const override
     {
         return _error.empty() ? nullptr : _error.c_str();
@@ -566,6 +576,48 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, MaxSocketBuffers);
+#    ifdef _WIN32
+        WSABUF wsaBuffers[MaxSocketBuffers];
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers, static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        iovec ioBuffers[MaxSocketBuffers];
+        for (size_t i = 0; i < count; i++)
+        {
+            ioBuffers[i].iov_base = const_cast<void*>(buffers[i].Data);
+            ioBuffers[i].iov_len = buffers[i].Size;
+        }
+
+        msghdr message{};
+        message.msg_iov = ioBuffers;
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -895,6 +947,147 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+#    ifdef __linux__
+/**
+ * Registers the sockets with epoll once, so waiting costs nothing per idle connection.
+ */
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    std::vector<epoll_event> _events;
+    std::vector<ITcpSocket*> _ready;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket* socket) override
+    {
+        auto handle = static_cast<TcpSocket*>(socket)->GetHandle();
+        if (handle != INVALID_SOCKET)
+        {
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.ptr = socket;
+            if (epoll_ctl(_epoll, EPOLL_CTL_ADD, handle, &ev) == 0)
+            {
+                _events.emplace_back();
+            }
+        }
+    }
+
+    void Remove(ITcpSocket* socket) override
+    {
+        // A closed socket has already been dropped by epoll and its descriptor may have been reused.
+        auto handle = static_cast<TcpSocket*>(socket)->GetHandle();
+        if (handle != INVALID_SOCKET && epoll_ctl(_epoll, EPOLL_CTL_DEL, handle, nullptr) == 0)
+        {
+            _events.pop_back();
+        }
+    }
+
+    const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) override
+    {
+        _ready.clear();
+        if (!_events.empty())
+        {
+            auto count = epoll_wait(_epoll, _events.data(), static_cast<int>(_events.size()), static_cast<int>(timeoutMs));
+            for (int i = 0; i < count; i++)
+            {
+                _ready.push_back(static_cast<ITcpSocket*>(_events[i].data.ptr));
+            }
+        }
+        else if (timeoutMs != 0)
+        {
+            platform_sleep(timeoutMs);
+        }
+        return _ready;
+    }
+};
+#    else
+/**
+ * Falls back to poll, rebuilding the descriptor list on every wait.
+ */
+class PollSocketPoller final : public ISocketPoller
+{
+private:
+#        ifdef _WIN32
+    using pollfd = WSAPOLLFD;
+#        endif
+
+    std::vector<ITcpSocket*> _sockets;
+    std::vector<pollfd> _fds;
+    std::vector<ITcpSocket*> _ready;
+
+public:
+    void Add(ITcpSocket* socket) override
+    {
+        _sockets.push_back(socket);
+    }
+
+    void Remove(ITcpSocket* socket) override
+    {
+        _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), socket), _sockets.end());
+    }
+
+    const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) override
+    {
+        _ready.clear();
+        _fds.clear();
+        for (auto socket : _sockets)
+        {
+            pollfd fd{};
+            fd.fd = static_cast<TcpSocket*>(socket)->GetHandle();
+            fd.events = POLLIN;
+            _fds.push_back(fd);
+        }
+
+        if (!_fds.empty())
+        {
+#        ifdef _WIN32
+            auto count = WSAPoll(_fds.data(), static_cast<ULONG>(_fds.size()), static_cast<INT>(timeoutMs));
+#        else
+            auto count = poll(_fds.data(), static_cast<nfds_t>(_fds.size()), static_cast<int>(timeoutMs));
+#        endif
+            for (size_t i = 0; i < _fds.size() && count > 0; i++)
+            {
+                if (_fds[i].revents != 0)
+                {
+                    _ready.push_back(_sockets[i]);
+                }
+            }
+        }
+        else if (timeoutMs != 0)
+        {
+            platform_sleep(timeoutMs);
+        }
+        return _ready;
+    }
+};
+#    endif
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+#    ifdef __linux__
+    return std::make_unique<EpollSocketPoller>();
+#    else
+    return std::make_unique<PollSocketPoller>();
+#    endif
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
@@ -33,6 +33,18 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+/**
+ * A block of memory passed to a single vectored send.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
+// Maximum number of buffers passed to a single vectored send, well within IOV_MAX on every platform.
+constexpr size_t MaxSocketBuffers = 16;
+
 /**
  * Represents an address and port.
  */
@@ -66,6 +78,8 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends the buffers in order with a single system call, returns the number of bytes sent.
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -98,8 +112,27 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Waits for activity on a set of TCP sockets, so that only the sockets that are ready need to be serviced.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket* socket) abstract;
+    virtual void Remove(ITcpSocket* socket) abstract;
+
+    /**
+     * Blocks for up to the given time until a socket has data to read, a pending connection or has been closed by the
+     * remote end. Readiness is level triggered, a socket that is not drained is returned again by the next wait.
+     */
+    virtual const std::vector<ITcpSocket*>& Wait(uint32_t timeoutMs) abstract;
+};
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
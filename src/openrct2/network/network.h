@@ -53,6 +53,7 @@ bool network_gamestate_snapshots_enabled();
 void network_update();
 void network_process_pending();
 void network_flush();
+void network_wait_for_data(uint32_t timeoutMs);
 
 NetworkAuth network_get_authstatus();
 uint32_t network_get_server_tick();
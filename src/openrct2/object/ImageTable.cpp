@@ -16,9 +16,12 @@
 #include "../core/FileScanner.h"
 #include "../core/IStream.hpp"
 #include "../core/Json.hpp"
+#include "../core/MemoryMappedFile.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/ImageImporter.h"
+#include "../rct12/SawyerChunkReader.h"
 #include "../sprites.h"
 #include "Object.h"
 #include "ObjectFactory.h"
@@ -321,23 +324,15 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
         }
 
         auto dataSize = static_cast<size_t>(imageDataSize);
-        auto data = std::make_unique<uint8_t[]>(dataSize);
-        if (data == nullptr)
-        {
-            context->LogError(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table too large.");
-            throw std::runtime_error("Image table too large.");
-        }
 
         // Read g1 element headers
-        uintptr_t imageDataBase = reinterpret_cast<uintptr_t>(data.get());
         std::vector<rct_g1_element> newEntries;
+        std::vector<uint32_t> imageOffsets;
         for (uint32_t i = 0; i < numImages; i++)
         {
-            rct_g1_element g1Element;
-
-            uintptr_t imageDataOffset = static_cast<uintptr_t>(stream->ReadValue<uint32_t>());
-            g1Element.offset = reinterpret_cast<uint8_t*>(imageDataBase + imageDataOffset);
+            rct_g1_element g1Element{};
 
+            imageOffsets.push_back(stream->ReadValue<uint32_t>());
             g1Element.width = stream->ReadValue<int16_t>();
             g1Element.height = stream->ReadValue<int16_t>();
             g1Element.x_offset = stream->ReadValue<int16_t>();
@@ -348,6 +343,36 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
             newEntries.push_back(g1Element);
         }
 
+        auto lazySourcePath = context->GetLazyImageSourcePath();
+        if (!lazySourcePath.empty() && _entries.empty())
+        {
+            _lazySourcePath = lazySourcePath;
+            _lazyChunkSize = static_cast<size_t>(stream->GetLength());
+            _lazyDataOffset = static_cast<size_t>(stream->GetPosition());
+            _lazyDataSize = dataSize;
+            _lazyImageOffsets = std::move(imageOffsets);
+            _entries = std::move(newEntries);
+
+            auto remainingData = _lazyChunkSize - _lazyDataOffset;
+            if (remainingData < dataSize)
+            {
+                context->LogWarning(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table size shorter than expected.");
+            }
+            stream->SetPosition(_lazyDataOffset + std::min(remainingData, dataSize));
+            return;
+        }
+
+        auto data = std::make_unique<uint8_t[]>(dataSize);
+        if (data == nullptr)
+        {
+            context->LogError(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table too large.");
+            throw std::runtime_error("Image table too large.");
+        }
+        for (uint32_t i = 0; i < numImages; i++)
+        {
+            newEntries[i].offset = data.get() + imageOffsets[i];
+        }
+
         // Read g1 element data
         size_t readBytes = static_cast<size_t>(stream->TryRead(data.get(), dataSize));
 
@@ -369,6 +394,54 @@ void ImageTable::Read(IReadObjectContext* context, OpenRCT2::IStream* stream)
     }
 }
 
+const rct_g1_element* ImageTable::LoadImages()
+{
+    if (_data == nullptr)
+    {
+        try
+        {
+            auto file = MemoryMappedFile(_lazySourcePath);
+            auto stream = MemoryStream(file.GetData(), file.GetLength());
+            stream.SetPosition(sizeof(rct_object_entry));
+            auto chunk = SawyerChunkReader(&stream).ReadChunk();
+            if (chunk->GetLength() != _lazyChunkSize)
+            {
+                throw std::runtime_error("Object file has changed since it was loaded.");
+            }
+
+            auto data = std::make_unique<uint8_t[]>(_lazyDataSize);
+            auto availableBytes = std::min(_lazyDataSize, _lazyChunkSize - _lazyDataOffset);
+            std::copy_n(static_cast<const uint8_t*>(chunk->GetData()) + _lazyDataOffset, availableBytes, data.get());
+            std::fill_n(data.get() + availableBytes, _lazyDataSize - availableBytes, 0);
+            for (size_t i = 0; i < _entries.size(); i++)
+            {
+                _entries[i].offset = data.get() + _lazyImageOffsets[i];
+            }
+            _data = std::move(data);
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to load images from '%s': %s", _lazySourcePath.c_str(), e.what());
+            return nullptr;
+        }
+    }
+    return _entries.data();
+}
+
+void ImageTable::UnloadImages()
+{
+    for (auto& entry : _entries)
+    {
+        entry.offset = nullptr;
+    }
+    _data = nullptr;
+}
+
+size_t ImageTable::GetImageDataSize() const
+{
+    return _lazyDataSize;
+}
+
 void ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 {
     Guard::Assert(root.is_object(), "ImageTable::ReadJson expects parameter root to be object");
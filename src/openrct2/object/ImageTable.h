@@ -14,6 +14,7 @@
 #include "../drawing/Drawing.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 struct IReadObjectContext;
@@ -22,12 +23,19 @@ namespace OpenRCT2
     struct IStream;
 }
 
-class ImageTable
+class ImageTable : public ILazyImageSource
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
     std::vector<rct_g1_element> _entries;
 
+    // Set for tables read with only their headers, the pixel data is read from the object file again once drawn.
+    std::string _lazySourcePath;
+    size_t _lazyChunkSize{};
+    size_t _lazyDataOffset{};
+    size_t _lazyDataSize{};
+    std::vector<uint32_t> _lazyImageOffsets;
+
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
@@ -46,7 +54,7 @@ public:
     ImageTable() = default;
     ImageTable(const ImageTable&) = delete;
     ImageTable& operator=(const ImageTable&) = delete;
-    ~ImageTable();
+    ~ImageTable() override;
 
     void Read(IReadObjectContext* context, OpenRCT2::IStream* stream);
     /**
@@ -62,4 +70,15 @@ public:
         return static_cast<uint32_t>(_entries.size());
     }
     void AddImage(const rct_g1_element* g1);
+
+    /**
+     * The table to pass to gfx_object_allocate_images, nullptr if the pixel data is already loaded.
+     */
+    ILazyImageSource* GetLazySource()
+    {
+        return _lazySourcePath.empty() ? nullptr : this;
+    }
+    const rct_g1_element* LoadImages() override;
+    void UnloadImages() override;
+    size_t GetImageDataSize() const override;
 };
@@ -150,6 +150,10 @@ struct IReadObjectContext
     virtual std::string_view GetObjectIdentifier() abstract;
     virtual IObjectRepository& GetObjectRepository() abstract;
     virtual bool ShouldLoadImages() abstract;
+    /**
+     * Path of the legacy object file being read if the image table should only read its pixel data once drawn.
+     */
+    virtual std::string_view GetLazyImageSourcePath() abstract;
     virtual std::vector<uint8_t> GetData(const std::string_view& path) abstract;
 
     virtual void LogWarning(uint32_t code, const utf8* text) abstract;
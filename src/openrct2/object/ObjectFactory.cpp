@@ -12,9 +12,9 @@
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
 #include "../core/File.h"
-#include "../core/FileStream.hpp"
 #include "../core/Json.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -89,6 +89,7 @@ private:
 
     std::string _identifier;
     bool _loadImages;
+    std::string _lazyImageSourcePath;
     std::string _basePath;
     bool _wasWarning = false;
     bool _wasError = false;
@@ -128,6 +129,16 @@ public:
         return _loadImages;
     }
 
+    std::string_view GetLazyImageSourcePath() override
+    {
+        return _lazyImageSourcePath;
+    }
+
+    void SetLazyImageSourcePath(const std::string& path)
+    {
+        _lazyImageSourcePath = path;
+    }
+
     std::vector<uint8_t> GetData(const std::string_view& path) override
     {
         if (_fileDataRetriever != nullptr)
@@ -200,14 +211,16 @@ namespace ObjectFactory
         }
     }
 
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path)
+    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path, bool loadImagesLazily)
     {
         log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
 
         Object* result = nullptr;
         try
         {
-            auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+            // Parsed straight from the mapped file, only the decoded chunk is copied.
+            auto file = OpenRCT2::MemoryMappedFile(path);
+            auto fs = OpenRCT2::MemoryStream(file.GetData(), file.GetLength());
             auto chunkReader = SawyerChunkReader(&fs);
 
             rct_object_entry entry = fs.ReadValue<rct_object_entry>();
@@ -225,6 +238,10 @@ namespace ObjectFactory
 
                 auto chunkStream = OpenRCT2::MemoryStream(chunk->GetData(), chunk->GetLength());
                 auto readContext = ReadObjectContext(objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr);
+                if (loadImagesLazily)
+                {
+                    readContext.SetLazyImageSourcePath(path);
+                }
                 ReadObjectLegacy(result, &readContext, &chunkStream);
                 if (readContext.WasError())
                 {
@@ -19,7 +19,10 @@ struct rct_object_entry;
 
 namespace ObjectFactory
 {
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path);
+    /**
+     * @param loadImagesLazily Only keep the image headers, the pixel data is read from the file again once drawn.
+     */
+    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path, bool loadImagesLazily = false);
     Object* CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize);
     Object* CreateObjectFromZipFile(IObjectRepository& objectRepository, const std::string_view& path);
@@ -106,7 +106,8 @@ public:
         }
         else
         {
-            object = ObjectFactory::CreateObjectFromLegacyFile(_objectRepository, path.c_str());
+            object = ObjectFactory::CreateObjectFromLegacyFile(
+                _objectRepository, path.c_str(), gConfigGeneral.lazy_load_images);
         }
         if (object != nullptr)
         {
@@ -305,7 +306,7 @@ public:
         }
         else
         {
-            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str());
+            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str(), gConfigGeneral.lazy_load_images);
         }
     }
 
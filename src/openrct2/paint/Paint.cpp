@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -56,6 +57,46 @@ static void paint_ps_image_with_bounding_boxes(
 static void paint_ps_image(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
 static uint32_t paint_ps_colourify_image(uint32_t imageId, uint8_t spriteType, uint32_t viewFlags);
 
+void PaintEntryArena::UseChunk(size_t index)
+{
+    if (index == _chunks.size())
+    {
+        _chunks.push_back(std::make_unique<Chunk>());
+    }
+    _chunkIndex = index;
+    _next = _chunks[index]->Entries;
+    _end = _next + ChunkSize;
+}
+
+void PaintEntryArena::Reset()
+{
+    _highWaterMark = std::max(_highWaterMark, GetCount());
+    UseChunk(0);
+}
+
+size_t PaintEntryArena::GetCount() const
+{
+    if (_next == nullptr)
+    {
+        return 0;
+    }
+    return _chunkIndex * ChunkSize + (_next - _chunks[_chunkIndex]->Entries);
+}
+
+size_t PaintEntryArena::IndexOf(const void* entry) const
+{
+    for (size_t i = 0; i < _chunks.size(); i++)
+    {
+        const paint_entry* begin = _chunks[i]->Entries;
+        if (entry >= begin && entry < begin + ChunkSize)
+        {
+            auto offset = static_cast<size_t>(static_cast<const uint8_t*>(entry) - reinterpret_cast<const uint8_t*>(begin));
+            return i * ChunkSize + offset / sizeof(paint_entry);
+        }
+    }
+    return SIZE_MAX;
+}
+
 static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
 {
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
@@ -73,15 +114,13 @@ static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struc
 static paint_struct* sub_9819_c(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, CoordsXYZ boundBoxSize, CoordsXYZ boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-        return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
         return nullptr;
     }
 
-    paint_struct* ps = &session->NextFreePaintStruct->basic;
+    paint_struct* ps = &session->PaintEntries.Peek()->basic;
     ps->image_id = image_id;
 
     uint8_t swappedRotation = (session->CurrentRotation * 3) % 4; // swaps 1 and 3
@@ -314,7 +353,7 @@ template<> bool check_bounding_box<3>(const paint_struct_bound_box& initialBBox,
 }
 
 template<uint8_t _TRotation>
-static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
+static paint_struct* paint_arrange_structs_helper_rotation_reference(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
 {
     paint_struct* ps;
     paint_struct* ps_temp;
@@ -399,27 +438,27 @@ static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next
     }
 }
 
-static paint_struct* paint_arrange_structs_helper(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation)
+static paint_struct* paint_arrange_structs_helper_reference(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation)
 {
     switch (rotation)
     {
         case 0:
-            return paint_arrange_structs_helper_rotation<0>(ps_next, quadrantIndex, flag);
+            return paint_arrange_structs_helper_rotation_reference<0>(ps_next, quadrantIndex, flag);
         case 1:
-            return paint_arrange_structs_helper_rotation<1>(ps_next, quadrantIndex, flag);
+            return paint_arrange_structs_helper_rotation_reference<1>(ps_next, quadrantIndex, flag);
         case 2:
-            return paint_arrange_structs_helper_rotation<2>(ps_next, quadrantIndex, flag);
+            return paint_arrange_structs_helper_rotation_reference<2>(ps_next, quadrantIndex, flag);
         case 3:
-            return paint_arrange_structs_helper_rotation<3>(ps_next, quadrantIndex, flag);
+            return paint_arrange_structs_helper_rotation_reference<3>(ps_next, quadrantIndex, flag);
     }
     return nullptr;
 }
 
 /**
- *
+ * The original linked list implementation of paint_session_arrange, kept to verify the flat array version.
  *  rct2: 0x00688217
  */
-void paint_session_arrange(paint_session* session)
+void paint_session_arrange_reference(PaintSessionCore* session)
 {
     paint_struct* psHead = &session->PaintHead;
 
@@ -444,13 +483,208 @@ void paint_session_arrange(paint_session* session)
             }
         } while (++quadrantIndex <= session->QuadrantFrontIndex);
 
-        paint_struct* ps_cache = paint_arrange_structs_helper(
+        paint_struct* ps_cache = paint_arrange_structs_helper_reference(
             psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, session->CurrentRotation);
 
         quadrantIndex = session->QuadrantBackIndex;
         while (++quadrantIndex < session->QuadrantFrontIndex)
         {
-            ps_cache = paint_arrange_structs_helper(ps_cache, quadrantIndex & 0xFFFF, 0, session->CurrentRotation);
+            ps_cache = paint_arrange_structs_helper_reference(ps_cache, quadrantIndex & 0xFFFF, 0, session->CurrentRotation);
+        }
+    }
+}
+
+/**
+ * Paint structs are sorted as an index linked list over flat arrays instead of chasing next_quadrant_ps, the scans only
+ * touch the next indices and flags while the bounds are read for candidates. The algorithm itself is unchanged as the
+ * draw order depends on it exactly, including the quadrant flags left over from earlier passes.
+ */
+struct PaintSortList
+{
+    std::vector<uint32_t> Next;
+    std::vector<uint8_t> QuadrantFlags;
+    std::vector<uint16_t> QuadrantIndex;
+    std::vector<paint_struct_bound_box> Bounds;
+    std::vector<paint_struct*> Structs;
+};
+
+struct PaintSortView
+{
+    uint32_t* Next;
+    uint8_t* QuadrantFlags;
+    const uint16_t* QuadrantIndex;
+    const paint_struct_bound_box* Bounds;
+};
+
+static constexpr uint32_t PAINT_SORT_NULL = UINT32_MAX;
+
+// Paint sessions are arranged from several job threads at once.
+static thread_local PaintSortList _paintSortList;
+
+template<uint8_t _TRotation>
+static uint32_t paint_arrange_structs_helper_rotation(const PaintSortView& list, uint32_t psNext, uint16_t quadrantIndex, uint8_t flag)
+{
+    uint32_t* next = list.Next;
+    uint8_t* flags = list.QuadrantFlags;
+    const uint16_t* quadrants = list.QuadrantIndex;
+    const paint_struct_bound_box* bounds = list.Bounds;
+
+    uint32_t ps;
+    uint32_t psTemp;
+    do
+    {
+        ps = psNext;
+        psNext = next[psNext];
+        if (psNext == PAINT_SORT_NULL)
+            return ps;
+    } while (quadrantIndex > quadrants[psNext]);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    uint32_t psCache = ps;
+
+    psTemp = ps;
+    do
+    {
+        ps = next[ps];
+        if (ps == PAINT_SORT_NULL)
+            break;
+
+        if (quadrants[ps] > quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (quadrants[ps] == quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (quadrants[ps] == quadrantIndex)
+        {
+            flags[ps] = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (quadrants[ps] <= quadrantIndex + 1);
+    ps = psTemp;
+
+    while (true)
+    {
+        while (true)
+        {
+            psNext = next[ps];
+            if (psNext == PAINT_SORT_NULL)
+                return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER)
+                return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_IDENTICAL)
+                break;
+            ps = psNext;
+        }
+
+        flags[psNext] &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        psTemp = ps;
+
+        const paint_struct_bound_box initialBBox = bounds[psNext];
+
+        while (true)
+        {
+            ps = psNext;
+            psNext = next[psNext];
+            if (psNext == PAINT_SORT_NULL)
+                break;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER)
+                break;
+            if (!(flags[psNext] & PAINT_QUADRANT_FLAG_NEXT))
+                continue;
+
+            const bool compareResult = check_bounding_box<_TRotation>(initialBBox, bounds[psNext]);
+
+            if (compareResult)
+            {
+                next[ps] = next[psNext];
+                uint32_t psTemp2 = next[psTemp];
+                next[psTemp] = psNext;
+                next[psNext] = psTemp2;
+                psNext = ps;
+            }
+        }
+
+        ps = psTemp;
+    }
+}
+
+static uint32_t paint_arrange_structs_helper(
+    const PaintSortView& list, uint32_t psNext, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation)
+{
+    switch (rotation)
+    {
+        case 0:
+            return paint_arrange_structs_helper_rotation<0>(list, psNext, quadrantIndex, flag);
+        case 1:
+            return paint_arrange_structs_helper_rotation<1>(list, psNext, quadrantIndex, flag);
+        case 2:
+            return paint_arrange_structs_helper_rotation<2>(list, psNext, quadrantIndex, flag);
+        case 3:
+            return paint_arrange_structs_helper_rotation<3>(list, psNext, quadrantIndex, flag);
+    }
+    return PAINT_SORT_NULL;
+}
+
+/**
+ *
+ *  rct2: 0x00688217
+ */
+void paint_session_arrange(PaintSessionCore* session)
+{
+    paint_struct* psHead = &session->PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+
+    uint32_t quadrantIndex = session->QuadrantBackIndex;
+    if (quadrantIndex == UINT32_MAX)
+    {
+        return;
+    }
+
+    // Flatten the quadrant lists in order, entry 0 is the head.
+    auto& list = _paintSortList;
+    list.Next.clear();
+    list.QuadrantFlags.clear();
+    list.QuadrantIndex.clear();
+    list.Bounds.clear();
+    list.Structs.clear();
+    list.Next.push_back(PAINT_SORT_NULL);
+    list.QuadrantFlags.push_back(0);
+    list.QuadrantIndex.push_back(0);
+    list.Bounds.push_back({});
+    list.Structs.push_back(psHead);
+    do
+    {
+        for (paint_struct* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            list.Next.back() = static_cast<uint32_t>(list.Next.size());
+            list.Next.push_back(PAINT_SORT_NULL);
+            list.QuadrantFlags.push_back(ps->quadrant_flags);
+            list.QuadrantIndex.push_back(ps->quadrant_index);
+            list.Bounds.push_back(ps->bounds);
+            list.Structs.push_back(ps);
+        }
+    } while (++quadrantIndex <= session->QuadrantFrontIndex);
+
+    PaintSortView view{ list.Next.data(), list.QuadrantFlags.data(), list.QuadrantIndex.data(), list.Bounds.data() };
+    uint32_t psCache = paint_arrange_structs_helper(
+        view, 0, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, session->CurrentRotation);
+
+    quadrantIndex = session->QuadrantBackIndex;
+    while (++quadrantIndex < session->QuadrantFrontIndex)
+    {
+        psCache = paint_arrange_structs_helper(view, psCache, quadrantIndex & 0xFFFF, 0, session->CurrentRotation);
+    }
+
+    // Write the sorted order back to the paint structs.
+    for (uint32_t i = 0; i != PAINT_SORT_NULL; i = list.Next[i])
+    {
+        auto next = list.Next[i];
+        list.Structs[i]->next_quadrant_ps = next != PAINT_SORT_NULL ? list.Structs[next] : nullptr;
+        if (i != 0)
+        {
+            list.Structs[i]->quadrant_flags = list.QuadrantFlags[i];
         }
     }
 }
@@ -713,18 +947,13 @@ paint_struct* sub_98196C(
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return nullptr;
-    }
-
     auto g1Element = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1Element == nullptr)
     {
         return nullptr;
     }
 
-    paint_struct* ps = &session->NextFreePaintStruct->basic;
+    paint_struct* ps = &session->PaintEntries.Peek()->basic;
     ps->image_id = image_id;
 
     CoordsXYZ coord_3d = {
@@ -832,7 +1061,7 @@ paint_struct* sub_98196C(
     }
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     return ps;
 }
@@ -891,7 +1120,7 @@ paint_struct* sub_98197C(
     int32_t positionHash = attach.x + attach.y;
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -933,7 +1162,7 @@ paint_struct* sub_98198C(
     }
 
     session->LastRootPS = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -975,7 +1204,7 @@ paint_struct* sub_98199C(
     old_ps->children = ps;
 
     session->LastRootPS = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -1006,11 +1235,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct* ps = &session->PaintEntries.Peek()->attached;
     ps->image_id = image_id;
     ps->x = x;
     ps->y = y;
@@ -1023,7 +1248,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
 
     session->UnkF1AD2C = ps;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     return true;
 }
@@ -1038,11 +1263,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
  */
 bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, int16_t x, int16_t y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct* ps = &session->PaintEntries.Peek()->attached;
 
     ps->image_id = image_id;
     ps->x = x;
@@ -1055,7 +1276,7 @@ bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, int1
         return false;
     }
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     attached_paint_struct* oldFirstAttached = masterPs->attached_ps;
     masterPs->attached_ps = ps;
@@ -1081,12 +1302,7 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return;
-    }
-
-    paint_string_struct* ps = &session->NextFreePaintStruct->string;
+    paint_string_struct* ps = &session->PaintEntries.Peek()->string;
     ps->string_id = string_id;
     ps->next = nullptr;
     ps->args[0] = amount;
@@ -1105,7 +1321,7 @@ void paint_floating_money_effect(
     ps->x = coord.x + offset_x;
     ps->y = coord.y;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     if (session->LastPSString == nullptr)
     {
@@ -14,6 +14,10 @@
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 struct TileElement;
 enum ViewportInteractionItem : uint8_t;
 
@@ -134,18 +138,79 @@ struct tunnel_entry
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT 65
 
-struct paint_session
+/**
+ * Chunked storage for the paint entries of a session. Chunks are kept when the arena is reset, so a pooled session
+ * stops allocating once it has grown to fit the views it paints.
+ */
+class PaintEntryArena
+{
+public:
+    static constexpr size_t ChunkSize = 512;
+
+private:
+    struct Chunk
+    {
+        paint_entry Entries[ChunkSize];
+    };
+
+    std::vector<std::unique_ptr<Chunk>> _chunks;
+    size_t _chunkIndex = 0;
+    paint_entry* _next = nullptr;
+    paint_entry* _end = nullptr;
+    size_t _highWaterMark = 0;
+
+    void UseChunk(size_t index);
+
+public:
+    /**
+     * The entry claimed by the next call to Commit, it may be written to before deciding whether to keep it.
+     */
+    paint_entry* Peek()
+    {
+        return _next;
+    }
+
+    void Commit()
+    {
+        if (++_next == _end)
+        {
+            UseChunk(_chunkIndex + 1);
+        }
+    }
+
+    void Reset();
+    size_t GetCount() const;
+    size_t GetHighWaterMark() const
+    {
+        return std::max(_highWaterMark, GetCount());
+    }
+    void ResetHighWaterMark()
+    {
+        _highWaterMark = 0;
+    }
+
+    /**
+     * Returns the position of a committed entry in allocation order, used to record sessions with relative offsets.
+     */
+    size_t IndexOf(const void* entry) const;
+    const paint_entry& operator[](size_t index) const
+    {
+        return _chunks[index / ChunkSize]->Entries[index % ChunkSize];
+    }
+};
+
+/**
+ * The parts of a paint session needed to arrange and draw it, without the entry storage.
+ */
+struct PaintSessionCore
 {
     rct_drawpixelinfo DPI;
-    paint_entry PaintStructs[4000];
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct PaintHead;
     uint32_t ViewFlags;
     uint32_t QuadrantBackIndex;
     uint32_t QuadrantFrontIndex;
     const void* CurrentlyDrawnItem;
-    paint_entry* EndOfPaintStructArray;
-    paint_entry* NextFreePaintStruct;
     CoordsXY SpritePosition;
     paint_struct* LastRootPS;
     attached_paint_struct* UnkF1AD2C;
@@ -171,6 +236,20 @@ struct paint_session
     uint32_t TrackColours[4];
 };
 
+struct paint_session : public PaintSessionCore
+{
+    PaintEntryArena PaintEntries;
+};
+
+/**
+ * Copy of a paint session with its entries flattened and pointers replaced by entry indices, see BenchSpriteSort.
+ */
+struct RecordedPaintSession
+{
+    PaintSessionCore Session;
+    std::vector<paint_entry> Entries;
+};
+
 extern paint_session gPaintSession;
 
 // Globals for paint clipping
@@ -227,7 +306,8 @@ void paint_floating_money_effect(
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void paint_session_free(paint_session* session);
 void paint_session_generate(paint_session* session);
-void paint_session_arrange(paint_session* session);
+void paint_session_arrange(PaintSessionCore* session);
+void paint_session_arrange_reference(PaintSessionCore* session);
 void paint_draw_structs(paint_session* session);
 void paint_draw_money_structs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
@@ -14,10 +14,12 @@
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
 #include "../config/Config.h"
+#include "../core/JobPool.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Viewport.h"
 #include "../localisation/FormatCodes.h"
 #include "../localisation/Language.h"
 #include "../paint/Paint.h"
@@ -36,6 +38,9 @@ Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
 
 void Painter::Paint(IDrawingEngine& de)
 {
+    // Nothing is being drawn yet, so lazily loaded object images can be evicted safely.
+    gfx_trim_lazy_images();
+
     auto dpi = de.GetDrawingPixelInfo();
     if (gIntroState != IntroState::None)
     {
@@ -125,6 +130,31 @@ void Painter::PaintFPS(rct_drawpixelinfo* dpi)
 
     // Make area dirty so the text doesn't get drawn over the last
     gfx_set_dirty_blocks({ { screenCoords - ScreenCoordsXY{ 16, 4 } }, { gLastDrawStringX + 16, 16 } });
+
+    // Paint entry high-water mark and work-stealing counters of the viewport paint threads, per second
+    {
+        utf8 statsBuffer[128] = { 0 };
+        ch = statsBuffer;
+        ch = utf8_write_codepoint(ch, FORMAT_MEDIUMFONT);
+        ch = utf8_write_codepoint(ch, FORMAT_OUTLINE);
+        ch = utf8_write_codepoint(ch, FORMAT_WHITE);
+
+        if (viewport_get_paint_jobs() != nullptr)
+        {
+            snprintf(
+                ch, sizeof(statsBuffer) - (ch - statsBuffer), "entries %u  steals %u  idle %u ms  depth %u",
+                _paintEntryHighWaterMark, _paintJobSteals, _paintJobIdleMs, _paintJobQueueDepth);
+        }
+        else
+        {
+            snprintf(ch, sizeof(statsBuffer) - (ch - statsBuffer), "entries %u", _paintEntryHighWaterMark);
+        }
+
+        stringWidth = gfx_get_string_width(statsBuffer);
+        ScreenCoordsXY statsCoords(_uiContext->GetWidth() / 2 - (stringWidth / 2), screenCoords.y + 12);
+        gfx_draw_string(dpi, statsBuffer, 0, statsCoords);
+        gfx_set_dirty_blocks({ { statsCoords - ScreenCoordsXY{ 16, 4 } }, { gLastDrawStringX + 16, statsCoords.y + 16 } });
+    }
 }
 
 void Painter::MeasureFPS()
@@ -136,10 +166,33 @@ void Painter::MeasureFPS()
     {
         _currentFPS = _frames;
         _frames = 0;
+        MeasurePaintJobs();
     }
     _lastSecond = currentTime;
 }
 
+void Painter::MeasurePaintJobs()
+{
+    auto* paintJobs = viewport_get_paint_jobs();
+    if (paintJobs != nullptr)
+    {
+        auto stats = paintJobs->GetStats();
+        _paintJobSteals = static_cast<uint32_t>(stats.Steals);
+        _paintJobIdleMs = static_cast<uint32_t>(stats.IdleMicroseconds / 1000);
+        _paintJobQueueDepth = static_cast<uint32_t>(stats.PeakQueueDepth);
+        paintJobs->ResetStats();
+    }
+
+    // Most paint entries used by a single session since the last measurement
+    size_t paintEntries = 0;
+    for (auto& session : _paintSessionPool)
+    {
+        paintEntries = std::max(paintEntries, session->PaintEntries.GetHighWaterMark());
+        session->PaintEntries.ResetHighWaterMark();
+    }
+    _paintEntryHighWaterMark = static_cast<uint32_t>(paintEntries);
+}
+
 paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
     paint_session* session = nullptr;
@@ -161,8 +214,7 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     }
 
     session->DPI = *dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->PaintEntries.Reset();
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
     session->ViewFlags = viewFlags;
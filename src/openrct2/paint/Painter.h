@@ -41,6 +41,10 @@ namespace OpenRCT2
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
+            uint32_t _paintJobSteals = 0;
+            uint32_t _paintJobIdleMs = 0;
+            uint32_t _paintJobQueueDepth = 0;
+            uint32_t _paintEntryHighWaterMark = 0;
 
         public:
             explicit Painter(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -53,6 +57,7 @@ namespace OpenRCT2
             void PaintReplayNotice(rct_drawpixelinfo* dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo* dpi);
             void MeasureFPS();
+            void MeasurePaintJobs();
         };
     } // namespace Paint
 } // namespace OpenRCT2
@@ -0,0 +1,558 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../util/Util.h"
+#include "../world/Entrance.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+#include "GuestPathfinding.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+static constexpr uint32_t FOOTPATH_GRAPH_UNREACHABLE = std::numeric_limits<uint32_t>::max();
+// Distance tables of goals nobody heads for any more are dropped once this many have been computed.
+static constexpr size_t FOOTPATH_GRAPH_MAX_GOALS = 256;
+
+struct FootpathGraphLink
+{
+    int32_t Node;
+    Direction Edge;
+};
+
+// Where a node in the middle of a segment lies on it, for one of the two directions the segment can be walked in.
+struct FootpathGraphSegmentPosition
+{
+    int32_t Segment;
+    uint32_t Offset;
+    // The direction leaving the node towards the end of the segment.
+    Direction Edge;
+};
+
+struct FootpathGraphNode
+{
+    TileCoordsXYZ Location;
+    std::vector<FootpathGraphLink> Links;
+    uint16_t NumIncomingLinks = 0;
+    uint8_t Edges = 0;
+    bool IsPath = false;
+    bool IsSloped = false;
+    Direction SlopeDirection = 0;
+    bool IsWide = false;
+    bool IsQueue = false;
+    // The ride of a queue with two edges, which guests heading for other rides treat as a dead end.
+    ride_id_t QueueRideIndex = RIDE_ID_NULL;
+
+    // Nodes with exactly two links, both leading to nodes that link back, only lie in the middle of segments.
+    bool IsChain = false;
+    uint8_t NumSegmentPositions = 0;
+    std::array<FootpathGraphSegmentPosition, 2> SegmentPositions;
+
+    // Index into the distance tables, for nodes that are not chain nodes.
+    int32_t Junction = -1;
+    std::vector<int32_t> Segments;
+    std::vector<int32_t> IncomingSegments;
+};
+
+struct FootpathGraphSegment
+{
+    int32_t From;
+    int32_t To;
+    uint32_t Length;
+    Direction Edge;
+};
+
+struct FootpathGraphGoal
+{
+    TileCoordsXYZ Location;
+    ride_id_t QueueRideIndex;
+    bool IgnoreForeignQueues;
+};
+
+struct FootpathGraphDistances
+{
+    int32_t GoalNode = -1;
+    // The number of tiles walked from each junction to the goal.
+    std::vector<uint32_t> Distances;
+};
+
+static std::vector<FootpathGraphNode> _footpathGraphNodes;
+static std::vector<FootpathGraphSegment> _footpathGraphSegments;
+static std::unordered_map<uint32_t, int32_t> _footpathGraphNodeIndex;
+static int32_t _footpathGraphNumJunctions;
+static std::unordered_map<uint64_t, FootpathGraphDistances> _footpathGraphDistances;
+static std::vector<TileCoordsXY> _footpathGraphInvalidatedTiles;
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _footpathGraphInvalidatedTileFlags;
+static bool _footpathGraphAllInvalidated = true;
+
+static uint32_t footpath_graph_get_node_key(const TileCoordsXYZ& loc)
+{
+    return (static_cast<uint32_t>(loc.x) << 16) | (static_cast<uint32_t>(loc.y) << 8) | static_cast<uint32_t>(loc.z);
+}
+
+static int32_t footpath_graph_find_node(const TileCoordsXYZ& loc)
+{
+    if (loc.x < 0 || loc.y < 0 || loc.x >= MAXIMUM_MAP_SIZE_TECHNICAL || loc.y >= MAXIMUM_MAP_SIZE_TECHNICAL || loc.z < 0
+        || loc.z > std::numeric_limits<uint8_t>::max())
+    {
+        return -1;
+    }
+
+    auto it = _footpathGraphNodeIndex.find(footpath_graph_get_node_key(loc));
+    return it != _footpathGraphNodeIndex.end() ? it->second : -1;
+}
+
+static int32_t footpath_graph_get_or_add_node(const TileCoordsXYZ& loc)
+{
+    auto result = _footpathGraphNodeIndex.emplace(
+        footpath_graph_get_node_key(loc), static_cast<int32_t>(_footpathGraphNodes.size()));
+    if (result.second)
+    {
+        _footpathGraphNodes.emplace_back();
+        _footpathGraphNodes.back().Location = loc;
+    }
+    return result.first->second;
+}
+
+static void footpath_graph_add_path_nodes()
+{
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+                    continue;
+
+                // Overlaid paths are merged the same way peep_pathfind_choose_direction merges them.
+                auto pathElement = tileElement->AsPath();
+                auto& node = _footpathGraphNodes[footpath_graph_get_or_add_node({ x, y, tileElement->base_height })];
+                if (!node.IsPath)
+                {
+                    node.IsPath = true;
+                    node.IsSloped = pathElement->IsSloped();
+                    node.SlopeDirection = pathElement->GetSlopeDirection();
+                }
+                node.Edges |= path_get_guest_permitted_edges(pathElement);
+                node.IsWide |= pathElement->IsWide();
+                node.IsQueue |= pathElement->IsQueue();
+                if (pathElement->IsQueue() && bitcount(pathElement->GetEdges()) == 2 && node.QueueRideIndex == RIDE_ID_NULL)
+                {
+                    node.QueueRideIndex = pathElement->GetRideIndex();
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+}
+
+/**
+ * Whether a guest walking from a path in the given direction at height z reaches the given element, following the
+ * rules of peep_pathfind_heuristic_search. Shops and entrances end the walk.
+ */
+static bool footpath_graph_is_walkable(TileElement* tileElement, int32_t z, Direction edge, bool* isPath)
+{
+    *isPath = false;
+    switch (tileElement->GetType())
+    {
+        case TILE_ELEMENT_TYPE_TRACK:
+        {
+            if (tileElement->base_height != z)
+                return false;
+            auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+            return ride != nullptr && ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP);
+        }
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            if (tileElement->base_height != z)
+                return false;
+            switch (tileElement->AsEntrance()->GetEntranceType())
+            {
+                case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                case ENTRANCE_TYPE_RIDE_EXIT:
+                    return tileElement->GetDirection() == edge;
+                case ENTRANCE_TYPE_PARK_ENTRANCE:
+                    return true;
+            }
+            return false;
+        case TILE_ELEMENT_TYPE_PATH:
+            *isPath = true;
+            return IsValidPathZAndDirection(tileElement, z, edge);
+    }
+    return false;
+}
+
+static void footpath_graph_add_links()
+{
+    // Shops and entrances are appended as they are found but do not link anywhere themselves.
+    auto numPathNodes = _footpathGraphNodes.size();
+    for (size_t i = 0; i < numPathNodes; i++)
+    {
+        for (Direction edge = 0; edge < NumOrthogonalDirections; edge++)
+        {
+            const auto& node = _footpathGraphNodes[i];
+            if (!(node.Edges & (1 << edge)))
+                continue;
+
+            auto loc = node.Location;
+            if (node.IsSloped && node.SlopeDirection == edge)
+            {
+                loc.z += 2;
+            }
+            loc += TileDirectionDelta[edge];
+            auto tileElement = map_get_first_element_at(loc.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+
+            do
+            {
+                bool isPath;
+                if (tileElement->IsGhost() || !footpath_graph_is_walkable(tileElement, loc.z, edge, &isPath))
+                    continue;
+
+                // Paths are entered at their base height, which is lower than loc.z for paths sloping down.
+                auto target = isPath ? footpath_graph_find_node({ loc.x, loc.y, tileElement->base_height })
+                                     : footpath_graph_get_or_add_node(loc);
+                if (target == -1)
+                    continue;
+
+                auto& links = _footpathGraphNodes[i].Links;
+                if (std::none_of(links.begin(), links.end(), [target, edge](const FootpathGraphLink& link) {
+                        return link.Node == target && link.Edge == edge;
+                    }))
+                {
+                    links.push_back({ target, edge });
+                    _footpathGraphNodes[target].NumIncomingLinks++;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+}
+
+static bool footpath_graph_links_back(int32_t from, const FootpathGraphLink& link)
+{
+    const auto& links = _footpathGraphNodes[link.Node].Links;
+    return std::any_of(links.begin(), links.end(), [from, &link](const FootpathGraphLink& backLink) {
+        return backLink.Node == from && backLink.Edge == direction_reverse(link.Edge);
+    });
+}
+
+static void footpath_graph_find_chain_nodes()
+{
+    for (size_t i = 0; i < _footpathGraphNodes.size(); i++)
+    {
+        auto& node = _footpathGraphNodes[i];
+        auto nodeIndex = static_cast<int32_t>(i);
+        node.IsChain = node.IsPath && !node.IsWide && !node.IsQueue && node.Links.size() == 2 && node.NumIncomingLinks == 2
+            && node.Links[0].Edge != node.Links[1].Edge && node.Links[0].Node != nodeIndex
+            && node.Links[1].Node != nodeIndex && footpath_graph_links_back(nodeIndex, node.Links[0])
+            && footpath_graph_links_back(nodeIndex, node.Links[1]);
+    }
+}
+
+static void footpath_graph_add_segment(int32_t from, const FootpathGraphLink& link)
+{
+    auto segmentIndex = static_cast<int32_t>(_footpathGraphSegments.size());
+    auto current = link.Node;
+    auto edge = link.Edge;
+    uint32_t length = 1;
+    while (_footpathGraphNodes[current].IsChain)
+    {
+        auto& node = _footpathGraphNodes[current];
+        // Chain nodes link back to where they were entered from and on to the next node in the other direction.
+        const auto& onward = node.Links[0].Edge == direction_reverse(edge) ? node.Links[1] : node.Links[0];
+        if (node.NumSegmentPositions < node.SegmentPositions.size())
+        {
+            node.SegmentPositions[node.NumSegmentPositions++] = { segmentIndex, length, onward.Edge };
+        }
+        current = onward.Node;
+        edge = onward.Edge;
+        length++;
+    }
+    _footpathGraphSegments.push_back({ from, current, length, link.Edge });
+}
+
+static void footpath_graph_add_segments()
+{
+    bool chainsChanged;
+    do
+    {
+        _footpathGraphSegments.clear();
+        for (auto& node : _footpathGraphNodes)
+        {
+            node.NumSegmentPositions = 0;
+        }
+
+        for (size_t i = 0; i < _footpathGraphNodes.size(); i++)
+        {
+            if (_footpathGraphNodes[i].IsChain)
+                continue;
+
+            // Copied as adding segments updates the chain nodes.
+            auto links = _footpathGraphNodes[i].Links;
+            for (const auto& link : links)
+            {
+                footpath_graph_add_segment(static_cast<int32_t>(i), link);
+            }
+        }
+
+        // A loop of chain nodes without any junction on it is never walked, so split it at each of its nodes.
+        chainsChanged = false;
+        for (auto& node : _footpathGraphNodes)
+        {
+            if (node.IsChain && node.NumSegmentPositions < node.SegmentPositions.size())
+            {
+                node.IsChain = false;
+                chainsChanged = true;
+            }
+        }
+    } while (chainsChanged);
+
+    _footpathGraphNumJunctions = 0;
+    for (auto& node : _footpathGraphNodes)
+    {
+        if (!node.IsChain)
+        {
+            node.Junction = _footpathGraphNumJunctions++;
+        }
+    }
+    for (size_t i = 0; i < _footpathGraphSegments.size(); i++)
+    {
+        const auto& segment = _footpathGraphSegments[i];
+        _footpathGraphNodes[segment.From].Segments.push_back(static_cast<int32_t>(i));
+        _footpathGraphNodes[segment.To].IncomingSegments.push_back(static_cast<int32_t>(i));
+    }
+}
+
+static void footpath_graph_build()
+{
+    _footpathGraphNodes.clear();
+    _footpathGraphSegments.clear();
+    _footpathGraphNodeIndex.clear();
+    _footpathGraphDistances.clear();
+
+    footpath_graph_add_path_nodes();
+    footpath_graph_add_links();
+    footpath_graph_find_chain_nodes();
+    footpath_graph_add_segments();
+}
+
+static bool footpath_graph_tile_has_network_elements(const TileCoordsXY& loc)
+{
+    auto tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return false;
+
+    do
+    {
+        if (tileElement->IsGhost())
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_PATH:
+            case TILE_ELEMENT_TYPE_BANNER:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+            case TILE_ELEMENT_TYPE_TRACK:
+                return true;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+static void footpath_graph_update()
+{
+    if (!_footpathGraphAllInvalidated)
+    {
+        _footpathGraphAllInvalidated = std::any_of(
+            _footpathGraphInvalidatedTiles.begin(), _footpathGraphInvalidatedTiles.end(),
+            footpath_graph_tile_has_network_elements);
+    }
+    _footpathGraphInvalidatedTiles.clear();
+    _footpathGraphInvalidatedTileFlags.reset();
+
+    if (_footpathGraphAllInvalidated)
+    {
+        footpath_graph_build();
+        _footpathGraphAllInvalidated = false;
+    }
+}
+
+void footpath_graph_invalidate()
+{
+    _footpathGraphAllInvalidated = true;
+}
+
+void footpath_graph_invalidate_tile(const CoordsXY& loc)
+{
+    if (_footpathGraphAllInvalidated || !map_is_location_valid(loc))
+        return;
+
+    auto tileLoc = TileCoordsXY(loc);
+    auto flagIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+    if (!_footpathGraphInvalidatedTileFlags[flagIndex])
+    {
+        _footpathGraphInvalidatedTileFlags[flagIndex] = true;
+        _footpathGraphInvalidatedTiles.push_back(tileLoc);
+    }
+}
+
+static bool footpath_graph_is_blocked(const FootpathGraphNode& node, const FootpathGraphGoal& goal)
+{
+    if (!node.IsPath || node.IsWide)
+        return true;
+    return goal.IgnoreForeignQueues && node.QueueRideIndex != RIDE_ID_NULL && node.QueueRideIndex != goal.QueueRideIndex;
+}
+
+/**
+ * Walks the segments backwards from the goal, so that the distance of each junction is the length of the shortest walk
+ * from it to the goal. Walks never pass through nodes a guest could not walk through on the way to the goal.
+ */
+static void footpath_graph_compute_distances(const FootpathGraphGoal& goal, FootpathGraphDistances& result)
+{
+    result.Distances.assign(_footpathGraphNumJunctions, FOOTPATH_GRAPH_UNREACHABLE);
+    result.GoalNode = footpath_graph_find_node(goal.Location);
+    if (result.GoalNode == -1)
+        return;
+
+    using QueueEntry = std::pair<uint32_t, int32_t>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    auto relax = [&](int32_t nodeIndex, uint32_t distance) {
+        const auto& node = _footpathGraphNodes[nodeIndex];
+        if (nodeIndex != result.GoalNode && footpath_graph_is_blocked(node, goal))
+            return;
+
+        auto& nodeDistance = result.Distances[node.Junction];
+        if (distance < nodeDistance)
+        {
+            nodeDistance = distance;
+            queue.emplace(distance, nodeIndex);
+        }
+    };
+
+    const auto& goalNode = _footpathGraphNodes[result.GoalNode];
+    if (goalNode.IsChain)
+    {
+        for (const auto& position : goalNode.SegmentPositions)
+        {
+            relax(_footpathGraphSegments[position.Segment].From, position.Offset);
+        }
+    }
+    else
+    {
+        relax(result.GoalNode, 0);
+    }
+
+    while (!queue.empty())
+    {
+        auto [distance, nodeIndex] = queue.top();
+        queue.pop();
+        const auto& node = _footpathGraphNodes[nodeIndex];
+        if (distance > result.Distances[node.Junction])
+            continue;
+
+        for (auto segmentIndex : node.IncomingSegments)
+        {
+            const auto& segment = _footpathGraphSegments[segmentIndex];
+            relax(segment.From, distance + segment.Length);
+        }
+    }
+}
+
+static const FootpathGraphDistances& footpath_graph_get_distances(const FootpathGraphGoal& goal)
+{
+    auto key = (static_cast<uint64_t>(footpath_graph_get_node_key(goal.Location)) << 24)
+        | (static_cast<uint64_t>(goal.QueueRideIndex) << 1) | (goal.IgnoreForeignQueues ? 1 : 0);
+    auto it = _footpathGraphDistances.find(key);
+    if (it != _footpathGraphDistances.end())
+        return it->second;
+
+    if (_footpathGraphDistances.size() >= FOOTPATH_GRAPH_MAX_GOALS)
+    {
+        _footpathGraphDistances.clear();
+    }
+    auto& result = _footpathGraphDistances[key];
+    footpath_graph_compute_distances(goal, result);
+    return result;
+}
+
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, uint8_t edges, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues)
+{
+    footpath_graph_update();
+
+    auto startNode = footpath_graph_find_node(loc);
+    if (startNode == -1)
+        return INVALID_DIRECTION;
+
+    const auto& distances = footpath_graph_get_distances({ goal, queueRideIndex, ignoreForeignQueues });
+    if (distances.GoalNode == -1 || distances.GoalNode == startNode)
+        return INVALID_DIRECTION;
+
+    const auto& goalNode = _footpathGraphNodes[distances.GoalNode];
+    uint32_t bestCost = FOOTPATH_GRAPH_UNREACHABLE;
+    Direction bestEdge = INVALID_DIRECTION;
+    auto considerSegment = [&](int32_t segmentIndex, uint32_t offset, Direction edge) {
+        if (!(edges & (1 << edge)))
+            return;
+
+        const auto& segment = _footpathGraphSegments[segmentIndex];
+        uint32_t cost = FOOTPATH_GRAPH_UNREACHABLE;
+        if (goalNode.IsChain)
+        {
+            for (const auto& position : goalNode.SegmentPositions)
+            {
+                if (position.Segment == segmentIndex && position.Offset > offset)
+                {
+                    cost = position.Offset - offset;
+                }
+            }
+        }
+        auto toDistance = distances.Distances[_footpathGraphNodes[segment.To].Junction];
+        if (cost == FOOTPATH_GRAPH_UNREACHABLE && toDistance != FOOTPATH_GRAPH_UNREACHABLE)
+        {
+            cost = segment.Length - offset + toDistance;
+        }
+        if (cost < bestCost || (cost == bestCost && cost != FOOTPATH_GRAPH_UNREACHABLE && edge < bestEdge))
+        {
+            bestCost = cost;
+            bestEdge = edge;
+        }
+    };
+
+    const auto& node = _footpathGraphNodes[startNode];
+    if (node.IsChain)
+    {
+        for (const auto& position : node.SegmentPositions)
+        {
+            considerSegment(position.Segment, position.Offset, position.Edge);
+        }
+    }
+    else
+    {
+        for (auto segmentIndex : node.Segments)
+        {
+            considerSegment(segmentIndex, 0, _footpathGraphSegments[segmentIndex].Edge);
+        }
+    }
+    return bestEdge;
+}
@@ -0,0 +1,31 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "../world/Location.hpp"
+
+/**
+ * The footpath network as guests see it, reduced to junctions and the lengths of the path segments between them. The
+ * graph is rebuilt the next time it is queried after a path, banner, entrance or track element has changed. For each goal
+ * guests head for, the distance from every junction to the goal is computed once and kept until the graph is rebuilt.
+ */
+void footpath_graph_invalidate();
+void footpath_graph_invalidate_tile(const CoordsXY& loc);
+
+/**
+ * Picks, out of edges, the direction starting the shortest walk from the path at loc to goal, preferring the lowest
+ * direction on ties. Like the heuristic search, queues for rides other than queueRideIndex are not walked through when
+ * ignoreForeignQueues is set and wide paths are never walked through. Returns INVALID_DIRECTION if the goal cannot be
+ * reached through any of the edges.
+ */
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, uint8_t edges, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues);
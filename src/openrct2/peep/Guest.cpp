@@ -28,11 +28,13 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "../world/AmenityMap.h"
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
 #include "../world/LargeScenery.h"
 #include "../world/Map.h"
 #include "../world/Park.h"
+#include "../world/RidePresence.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
@@ -1934,29 +1936,7 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     {
         // Take nearby rides into consideration
         constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                if (map_is_location_valid({ tileX, tileY }))
-                {
-                    auto tileElement = map_get_first_element_at({ tileX, tileY });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                rideConsideration[rideIndex] = true;
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
-            }
-        }
+        rideConsideration = ride_presence_get_rides_near({ x, y }, radius);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         for (auto& ride : GetRideManager())
@@ -2944,96 +2924,34 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
     if ((tile_element_height({ centre_x, centre_y })) > centre_z)
         return PEEP_THOUGHT_TYPE_NONE;
 
-    uint16_t num_scenery = 0;
-    uint16_t num_fountains = 0;
-    uint16_t nearby_music = 0;
-    uint16_t num_rubbish = 0;
+    auto amenities = amenity_map_get_near({ centre_x, centre_y }, 160);
+    if (amenities.HasMissingPathAdditions)
+        return PEEP_THOUGHT_TYPE_NONE;
 
-    int16_t initial_x = std::max(centre_x - 160, 0);
-    int16_t initial_y = std::max(centre_y - 160, 0);
-    int16_t final_x = std::min(centre_x + 160, MAXIMUM_MAP_SIZE_BIG);
-    int16_t final_y = std::min(centre_y + 160, MAXIMUM_MAP_SIZE_BIG);
+    uint16_t num_scenery = amenities.Scenery;
+    uint16_t num_fountains = amenities.Fountains;
+    uint16_t nearby_music = 0;
+    uint16_t num_rubbish = amenities.Rubbish;
 
-    for (int16_t x = initial_x; x < final_x; x += COORDS_XY_STEP)
+    auto nearbyRides = ride_presence_get_rides_in_range(
+        { centre_x - 160, centre_y - 160, centre_x + 160 - COORDS_XY_STEP, centre_y + 160 - COORDS_XY_STEP });
+    for (auto& ride : GetRideManager())
     {
-        for (int16_t y = initial_y; y < final_y; y += COORDS_XY_STEP)
-        {
-            TileElement* tileElement = map_get_first_element_at({ x, y });
-            if (tileElement == nullptr)
-                continue;
-            do
-            {
-                Ride* ride;
-                rct_scenery_entry* scenery;
-
-                switch (tileElement->GetType())
-                {
-                    case TILE_ELEMENT_TYPE_PATH:
-                        if (!tileElement->AsPath()->HasAddition())
-                            break;
-
-                        scenery = tileElement->AsPath()->GetAdditionEntry();
-                        if (scenery == nullptr)
-                        {
-                            return PEEP_THOUGHT_TYPE_NONE;
-                        }
-                        if (tileElement->AsPath()->AdditionIsGhost())
-                            break;
-
-                        if (scenery->path_bit.flags
-                            & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
-                        {
-                            num_fountains++;
-                            break;
-                        }
-                        if (tileElement->AsPath()->IsBroken())
-                        {
-                            num_rubbish++;
-                        }
-                        break;
-                    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
-                    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-                        num_scenery++;
-                        break;
-                    case TILE_ELEMENT_TYPE_TRACK:
-                        ride = get_ride(tileElement->AsTrack()->GetRideIndex());
-                        if (ride != nullptr)
-                        {
-                            if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RIDE_STATUS_CLOSED
-                                && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
-                            {
-                                if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
-
-                                if (ride->music == MUSIC_STYLE_ORGAN)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
-
-                                if (ride->type == RIDE_TYPE_DODGEMS)
-                                {
-                                    // Dodgems drown out music?
-                                    nearby_music |= 2;
-                                }
-                            }
-                        }
-                        break;
-                }
-            } while (!(tileElement++)->IsLastForTile());
-        }
-    }
+        if (!nearbyRides[ride.id])
+            continue;
 
-    for (auto litter : EntityList<Litter>(EntityListId::Litter))
-    {
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
+        if (ride.lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride.status != RIDE_STATUS_CLOSED
+            && !(ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
         {
-            num_rubbish++;
+            if (ride.type == RIDE_TYPE_MERRY_GO_ROUND || ride.music == MUSIC_STYLE_ORGAN)
+            {
+                nearby_music |= 1;
+            }
+            else if (ride.type == RIDE_TYPE_DODGEMS)
+            {
+                // Dodgems drown out music?
+                nearby_music |= 2;
+            }
         }
     }
 
@@ -3186,31 +3104,12 @@ template<typename T> static void peep_head_for_nearest_ride(Guest* peep, bool co
     {
         // Take nearby rides into consideration
         constexpr auto searchRadius = 10 * 32;
-        int32_t cx = floor2(peep->x, 32);
-        int32_t cy = floor2(peep->y, 32);
-        for (auto x = cx - searchRadius; x <= cx + searchRadius; x += COORDS_XY_STEP)
+        auto nearbyRides = ride_presence_get_rides_near({ peep->x, peep->y }, searchRadius);
+        for (const auto& ride : GetRideManager())
         {
-            for (auto y = cy - searchRadius; y <= cy + searchRadius; y += COORDS_XY_STEP)
+            if (nearbyRides[ride.id] && predicate(ride))
             {
-                if (map_is_location_valid({ x, y }))
-                {
-                    auto tileElement = map_get_first_element_at({ x, y });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                auto ride = get_ride(rideIndex);
-                                if (ride != nullptr && predicate(*ride))
-                                {
-                                    rideConsideration[rideIndex] = true;
-                                }
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
+                rideConsideration[ride.id] = true;
             }
         }
     }
@@ -6292,6 +6191,7 @@ static void peep_update_walking_break_scenery(Peep* peep)
     }
 
     tileElement->AsPath()->SetIsBroken(true);
+    amenity_map_invalidate_tile(peep->NextLoc);
 
     map_invalidate_tile_zoom1({ peep->NextLoc, tileElement->GetBaseZ(), tileElement->GetBaseZ() + 32 });
 
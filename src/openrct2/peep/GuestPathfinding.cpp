@@ -9,7 +9,9 @@
 
 #include "GuestPathfinding.h"
 
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../network/network.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -17,6 +19,7 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "FootpathGraph.h"
 #include "Peep.h"
 #include "Staff.h"
 
@@ -95,8 +98,6 @@ static TileElement* get_banner_on_path(TileElement* path_element)
 
 static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
 {
-    if (_peepPathFindIsStaff)
-        return edges;
     TileElement* bannerElement = get_banner_on_path(reinterpret_cast<TileElement*>(pathElement));
     if (bannerElement != nullptr)
     {
@@ -112,6 +113,13 @@ static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
 static int32_t path_get_permitted_edges(PathElement* pathElement)
+{
+    if (_peepPathFindIsStaff)
+        return pathElement->GetEdgesAndCorners() & 0x0F;
+    return path_get_guest_permitted_edges(pathElement);
+}
+
+uint8_t path_get_guest_permitted_edges(PathElement* pathElement)
 {
     return banner_clear_path_edges(pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
 }
@@ -1391,8 +1399,26 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
 
     int32_t chosen_edge = bitscanforward(edges);
 
+    /* With cached pathfinding, guests take the edge on the shortest walk
+     * to the goal through the footpath graph. It does not know about
+     * guests crossing wide paths, and as the setting is local while every
+     * network player has to make the same choice, it is not used then.
+     * If the goal cannot be reached through the footpath graph, the
+     * heuristic search is used instead. */
+    Direction plannedEdge = INVALID_DIRECTION;
+    if ((edges & ~(1 << chosen_edge)) && gConfigGeneral.cached_pathfinding && network_get_mode() == NETWORK_MODE_NONE
+        && peep->AssignedPeepType == PeepType::Guest && !first_tile_element->AsPath()->IsWide())
+    {
+        plannedEdge = footpath_graph_choose_direction(
+            loc, edges, goal, gPeepPathFindQueueRideIndex, gPeepPathFindIgnoreForeignQueues);
+    }
+
+    if (plannedEdge != INVALID_DIRECTION)
+    {
+        chosen_edge = plannedEdge;
+    }
     // Peep has multiple edges still to try.
-    if (edges & ~(1 << chosen_edge))
+    else if (edges & ~(1 << chosen_edge))
     {
         uint16_t best_score = 0xFFFF;
         uint8_t best_sub = 0xFF;
@@ -15,6 +15,7 @@
 
 struct Peep;
 struct Guest;
+struct PathElement;
 struct TileElement;
 
 // The tile position of the place the peep is trying to get to (park entrance/exit, ride
@@ -45,6 +46,9 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep);
 // moving in direction currentDirection.
 bool IsValidPathZAndDirection(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
 
+// Gets the connected edges of a path that guests may walk through, i.e. those not closed off by 'no entry' signs.
+uint8_t path_get_guest_permitted_edges(PathElement* pathElement);
+
 // Overall guest pathfinding AI. Sets up Peep::DestinationX/DestinationY (which they move to in a
 // straight line, no pathfinding). Called whenever the guest has arrived at their previously set destination.
 //
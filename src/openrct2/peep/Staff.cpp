@@ -432,23 +432,17 @@ void staff_toggle_patrol_area(int32_t staffIndex, const CoordsXY& coords)
  */
 Direction Staff::HandymanDirectionToNearestLitter() const
 {
-    uint16_t nearestLitterDist = 0xFFFF;
-    Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>(EntityListId::Litter))
-    {
-        uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > MAX_LITTER_DISTANCE)
+    auto nearestLitters = GetNearestEntities<Litter>(
+        EntityListId::Litter, { x, y }, 1, MAX_LITTER_DISTANCE,
+        [this](const Litter& litter) -> uint32_t {
+            return abs(litter.x - x) + abs(litter.y - y) + abs(litter.z - z) * 4;
+        },
+        [](const Litter&) { return true; });
+    if (nearestLitters.empty())
     {
         return INVALID_DIRECTION;
     }
+    auto nearestLitter = nearestLitters.front();
 
     auto litterTile = CoordsXY{ nearestLitter->x, nearestLitter->y }.ToTileStart();
 
@@ -42,12 +42,14 @@
 #include "../scenario/ScenarioSources.h"
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
+#include "../world/AmenityMap.h"
 #include "../world/Climate.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
 #include "../world/LargeScenery.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
+#include "../world/RidePresence.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Surface.h"
@@ -2798,6 +2800,9 @@ private:
         }
 
         gNextFreeTileElement = nextFreeTileElement;
+        map_reset_free_tile_elements();
+        ride_presence_invalidate_all();
+        amenity_map_invalidate_all();
     }
 
     void FixWalls()
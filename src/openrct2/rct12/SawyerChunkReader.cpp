@@ -192,11 +192,14 @@ size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void*
 
 size_t SawyerChunkReader::DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
 {
-    auto immBuffer = AllocateLargeTempBuffer();
-    auto immLength = DecodeChunkRLE(immBuffer, MAX_UNCOMPRESSED_CHUNK_SIZE, src, srcLength);
-    auto size = DecodeChunkRepeat(dst, dstCapacity, immBuffer, immLength);
-    FreeLargeTempBuffer(immBuffer);
-    return size;
+    // The intermediate buffer is kept for the next chunk, so its pages do not have to be faulted in again
+    thread_local std::unique_ptr<void, decltype(&FreeLargeTempBuffer)> immBuffer(nullptr, &FreeLargeTempBuffer);
+    if (immBuffer == nullptr)
+    {
+        immBuffer.reset(AllocateLargeTempBuffer());
+    }
+    auto immLength = DecodeChunkRLE(immBuffer.get(), MAX_UNCOMPRESSED_CHUNK_SIZE, src, srcLength);
+    return DecodeChunkRepeat(dst, dstCapacity, immBuffer.get(), immLength);
 }
 
 size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
@@ -221,7 +224,7 @@ size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const vo
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::fill_n(dst8, count, src8[i]);
+            std::memset(dst8, src8[i], count);
             dst8 += count;
         }
         else
@@ -239,7 +242,15 @@ size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const vo
                 throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
             }
 
-            std::memcpy(dst8, src8 + i + 1, rleCodeByte + 1);
+            // Most literals are short, copy those with a single fixed size copy when both buffers have room for it
+            if (rleCodeByte < 16 && i + 1 + 16 <= srcLength && dst8 + 16 <= dstEnd)
+            {
+                std::memcpy(dst8, src8 + i + 1, 16);
+            }
+            else
+            {
+                std::memcpy(dst8, src8 + i + 1, rleCodeByte + 1);
+            }
             dst8 += rleCodeByte + 1;
             i += rleCodeByte + 1;
         }
@@ -268,7 +279,17 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::memcpy(dst8, copySrc, count);
+            // Copies are at most 8 bytes, always copy a whole word when there is room for it
+            if (dst8 + 8 <= dstEnd)
+            {
+                uint64_t word;
+                std::memcpy(&word, copySrc, sizeof(word));
+                std::memcpy(dst8, &word, sizeof(word));
+            }
+            else
+            {
+                std::memcpy(dst8, copySrc, count);
+            }
             dst8 += count;
         }
     }
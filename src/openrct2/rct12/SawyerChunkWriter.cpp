@@ -12,11 +12,13 @@
 #include "../core/IStream.hpp"
 #include "../util/SawyerCoding.h"
 
-// Maximum buffer size to store compressed data, maximum of 16 MiB
+// Maximum buffer size to store compressed data, maximum of 16 MiB. The buffers are left uninitialised as
+// zeroing them would cost more than encoding most chunks.
 constexpr size_t MAX_COMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
 
-SawyerChunkWriter::SawyerChunkWriter(OpenRCT2::IStream* stream)
+SawyerChunkWriter::SawyerChunkWriter(OpenRCT2::IStream* stream, bool useRLE)
     : _stream(stream)
+    , _useRLE(useRLE)
 {
 }
 
@@ -27,11 +29,16 @@ void SawyerChunkWriter::WriteChunk(const SawyerChunk* chunk)
 
 void SawyerChunkWriter::WriteChunk(const void* src, size_t length, SAWYER_ENCODING encoding)
 {
+    if (!_useRLE && (encoding == SAWYER_ENCODING::RLE || encoding == SAWYER_ENCODING::RLECOMPRESSED))
+    {
+        encoding = SAWYER_ENCODING::NONE;
+    }
+
     sawyercoding_chunk_header header;
     header.encoding = static_cast<uint8_t>(encoding);
     header.length = static_cast<uint32_t>(length);
 
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
+    auto data = std::unique_ptr<uint8_t[]>(new uint8_t[MAX_COMPRESSED_CHUNK_SIZE]);
     size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), static_cast<const uint8_t*>(src), header);
 
     _stream->Write(data.get(), dataLength);
@@ -91,7 +98,7 @@ static size_t EncodeChunkRLE(const uint8_t* src_buffer, uint8_t* dst_buffer, siz
 
 void SawyerChunkWriter::WriteChunkTrack(const void* src, size_t length)
 {
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
+    auto data = std::unique_ptr<uint8_t[]>(new uint8_t[MAX_COMPRESSED_CHUNK_SIZE]);
     size_t dataLength = EncodeChunkRLE(static_cast<const uint8_t*>(src), data.get(), length);
 
     uint32_t checksum = 0;
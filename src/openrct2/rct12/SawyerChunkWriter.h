@@ -27,9 +27,13 @@ class SawyerChunkWriter final
 {
 private:
     OpenRCT2::IStream* const _stream = nullptr;
+    const bool _useRLE = true;
 
 public:
-    explicit SawyerChunkWriter(OpenRCT2::IStream* stream);
+    /**
+     * @param useRLE When false, chunks requested with RLE or RLE compressed encoding are written unencoded instead.
+     */
+    explicit SawyerChunkWriter(OpenRCT2::IStream* stream, bool useRLE = true);
 
     /**
      * Writes a chunk to the stream.
@@ -49,13 +49,83 @@
 
 #include <algorithm>
 #include <cstring>
-#include <functional>
+#include <future>
 #include <iterator>
 #include <optional>
+#include <stdexcept>
+
+/**
+ * Passes writes through to another stream while summing every byte written, as expected by
+ * sawyercoding_calculate_checksum.
+ */
+class ChecksumStream final : public OpenRCT2::IStream
+{
+private:
+    OpenRCT2::IStream* const _stream;
+    uint32_t _checksum = 0;
+
+public:
+    explicit ChecksumStream(OpenRCT2::IStream* stream)
+        : _stream(stream)
+    {
+    }
+
+    uint32_t GetChecksum() const
+    {
+        return _checksum;
+    }
+
+    bool CanRead() const override
+    {
+        return false;
+    }
+    bool CanWrite() const override
+    {
+        return true;
+    }
+
+    uint64_t GetLength() const override
+    {
+        return _stream->GetLength();
+    }
+    uint64_t GetPosition() const override
+    {
+        return _stream->GetPosition();
+    }
+    void SetPosition([[maybe_unused]] uint64_t position) override
+    {
+        throw std::runtime_error("ChecksumStream can not seek.");
+    }
+    void Seek([[maybe_unused]] int64_t offset, [[maybe_unused]] int32_t origin) override
+    {
+        throw std::runtime_error("ChecksumStream can not seek.");
+    }
+
+    void Read([[maybe_unused]] void* buffer, [[maybe_unused]] uint64_t length) override
+    {
+        throw std::runtime_error("ChecksumStream is write only.");
+    }
+    void Write(const void* buffer, uint64_t length) override
+    {
+        _checksum += sawyercoding_calculate_checksum(static_cast<const uint8_t*>(buffer), static_cast<size_t>(length));
+        _stream->Write(buffer, length);
+    }
+
+    uint64_t TryRead([[maybe_unused]] void* buffer, [[maybe_unused]] uint64_t length) override
+    {
+        return 0;
+    }
+
+    const void* GetData() const override
+    {
+        return nullptr;
+    }
+};
 
 S6Exporter::S6Exporter()
 {
     RemoveTracklessRides = false;
+    UseRLE = true;
     std::memset(&_s6, 0x00, sizeof(_s6));
 }
 
@@ -90,7 +160,10 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
     _s6.header.magic_number = S6_MAGIC_NUMBER;
     _s6.game_version_number = 201028;
 
-    auto chunkWriter = SawyerChunkWriter(stream);
+    // The checksum is accumulated as the file is written rather than read back afterwards
+    auto checksumStream = ChecksumStream(stream);
+    stream = &checksumStream;
+    auto chunkWriter = SawyerChunkWriter(stream, UseRLE);
 
     // 0: Write header chunk
     chunkWriter.WriteChunk(&_s6.header, SAWYER_ENCODING::ROTATE);
@@ -135,18 +208,8 @@ void S6Exporter::Save(OpenRCT2::IStream* stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
-    // Determine number of bytes written
-    size_t fileSize = stream->GetLength();
-
-    // Read all written bytes back into a single buffer
-    stream->SetPosition(0);
-    auto data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-        stream->ReadArray<uint8_t>(fileSize), Memory::Free<uint8_t>);
-    uint32_t checksum = sawyercoding_calculate_checksum(data.get(), fileSize);
-
     // Write the checksum on the end
-    stream->SetPosition(fileSize);
-    stream->WriteValue(checksum);
+    stream->WriteValue(checksumStream.GetChecksum());
 }
 
 void S6Exporter::Export()
@@ -1680,6 +1743,44 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
+static std::future<void> _pendingSave;
+
+/**
+ * Captures the park into a new exporter, this must be done on the main thread.
+ */
+static std::unique_ptr<S6Exporter> scenario_export(int32_t flags)
+{
+    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        window_close_construction_windows();
+    }
+
+    map_reorganise_elements();
+    viewport_set_saved_view();
+
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+    return s6exporter;
+}
+
+static void scenario_write(S6Exporter& s6exporter, const utf8* path, int32_t flags)
+{
+    if (flags & S6_SAVE_FLAG_SCENARIO)
+    {
+        s6exporter.SaveScenario(path);
+    }
+    else
+    {
+        s6exporter.SaveGame(path);
+    }
+}
+
 /**
  *
  *  rct2: 0x006754F5
@@ -1696,40 +1797,17 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         log_verbose("scenario_save(%s, SAVED GAME)", path);
     }
 
-    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
-    {
-        window_close_construction_windows();
-    }
-
-    map_reorganise_elements();
-    viewport_set_saved_view();
-
     bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            s6exporter->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
+        auto s6exporter = scenario_export(flags);
+        scenario_write(*s6exporter, path, flags);
         result = true;
     }
     catch (const std::exception& e)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
@@ -1739,3 +1817,50 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     }
     return result;
 }
+
+void scenario_save_async(const utf8* path, int32_t flags)
+{
+    // Packed objects are read from the object repository which is not safe to do off the main thread
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        scenario_save(path, flags);
+        return;
+    }
+
+    log_verbose("scenario_save_async(%s)", path);
+    scenario_wait_for_pending_save();
+
+    std::shared_ptr<S6Exporter> s6exporter;
+    try
+    {
+        s6exporter = scenario_export(flags);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+        return;
+    }
+    gfx_invalidate_screen();
+
+    // Encoding the chunks and writing the file only reads the captured copy of the park
+    _pendingSave = std::async(std::launch::async, [s6exporter, savePath = std::string(path), flags] {
+        try
+        {
+            scenario_write(*s6exporter, savePath.c_str(), flags);
+            log_verbose("Saved to %s", savePath.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to save park to '%s': '%s'", savePath.c_str(), e.what());
+        }
+    });
+}
+
+void scenario_wait_for_pending_save()
+{
+    if (_pendingSave.valid())
+    {
+        _pendingSave.wait();
+        _pendingSave = {};
+    }
+}
@@ -34,6 +34,8 @@ class S6Exporter final
 {
 public:
     bool RemoveTracklessRides;
+    // Network maps are written without RLE, they compress better that way.
+    bool UseRLE;
     std::vector<const ObjectRepositoryItem*> ExportObjectsList;
 
     S6Exporter();
@@ -81,6 +81,9 @@ static constexpr const int32_t RideInspectionInterval[] = {
     10, 20, 30, 45, 60, 120, 0, 0,
 };
 
+// Up to this many peeps find_closest_mechanic walks the peep list instead of searching the spatial index.
+static constexpr const uint16_t MECHANIC_SEARCH_MAX_LIST_WALK = 512;
+
 static std::vector<Ride> _rides;
 
 bool gGotoStartPlacementMode = false;
@@ -2700,51 +2703,65 @@ Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection)
  */
 Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspection)
 {
-    Peep* closestMechanic = nullptr;
-    uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
-
-    for (auto peep : EntityList<Staff>(EntityListId::Peep))
-    {
-        if (peep->AssignedStaffType != StaffType::Mechanic)
-            continue;
+    auto location = entrancePosition.ToTileStart();
+    auto checkPatrol = map_is_location_in_park(location);
+    auto distance = [&entrancePosition](const Staff& peep) -> uint32_t {
+        // Manhattan distance
+        return std::abs(peep.x - entrancePosition.x) + std::abs(peep.y - entrancePosition.y);
+    };
+    auto isAvailable = [forInspection, checkPatrol, &location](const Staff& peep) {
+        if (peep.AssignedStaffType != StaffType::Mechanic)
+            return false;
 
         if (!forInspection)
         {
-            if (peep->State == PeepState::HeadingToInspection)
+            if (peep.State == PeepState::HeadingToInspection)
             {
-                if (peep->SubState >= 4)
-                    continue;
+                if (peep.SubState >= 4)
+                    return false;
             }
-            else if (peep->State != PeepState::Patrolling)
-                continue;
+            else if (peep.State != PeepState::Patrolling)
+                return false;
 
-            if (!(peep->StaffOrders & STAFF_ORDERS_FIX_RIDES))
-                continue;
+            if (!(peep.StaffOrders & STAFF_ORDERS_FIX_RIDES))
+                return false;
         }
         else
         {
-            if (peep->State != PeepState::Patrolling || !(peep->StaffOrders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
+            if (peep.State != PeepState::Patrolling || !(peep.StaffOrders & STAFF_ORDERS_INSPECT_RIDES))
+                return false;
         }
 
-        auto location = entrancePosition.ToTileStart();
-        if (map_is_location_in_park(location))
-            if (!peep->AsStaff()->IsLocationInPatrol(location))
-                continue;
+        if (checkPatrol && !peep.IsLocationInPatrol(location))
+            return false;
 
-        if (peep->x == LOCATION_NULL)
-            continue;
+        return true;
+    };
 
-        // Manhattan distance
-        uint32_t distance = std::abs(peep->x - entrancePosition.x) + std::abs(peep->y - entrancePosition.y);
-        if (distance < closestDistance)
+    // With few peeps walking the list is cheaper than a spatial search that finds no available mechanic and ends up
+    // visiting every tile of the map.
+    if (GetEntityListCount(EntityListId::Peep) <= MECHANIC_SEARCH_MAX_LIST_WALK)
+    {
+        Peep* closestMechanic = nullptr;
+        uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
+        for (auto peep : EntityList<Staff>(EntityListId::Peep))
         {
-            closestDistance = distance;
-            closestMechanic = peep;
+            if (peep->x == LOCATION_NULL || !isAvailable(*peep))
+                continue;
+
+            uint32_t peepDistance = distance(*peep);
+            if (peepDistance < closestDistance)
+            {
+                closestDistance = peepDistance;
+                closestMechanic = peep;
+            }
         }
+        return closestMechanic;
     }
 
-    return closestMechanic;
+    auto mechanics = GetNearestEntities<Staff>(
+        EntityListId::Peep, entrancePosition, 1, std::numeric_limits<uint32_t>::max(), distance, isAvailable);
+    return mechanics.empty() ? nullptr : mechanics.front();
 }
 
 Staff* ride_get_mechanic(Ride* ride)
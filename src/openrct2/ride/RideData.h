@@ -29,7 +29,7 @@
 #include "Track.h"
 #include "TrackPaint.h"
 
-using ride_ratings_calculation = void (*)(Ride* ride);
+using ride_ratings_calculation = void (*)(Ride* ride, RideRatingCalculationData& state);
 struct RideComponentName
 {
     rct_string_id singular;
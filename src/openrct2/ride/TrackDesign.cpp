@@ -45,8 +45,10 @@
 #include "../rct1/Tables.h"
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
+#include "../world/AmenityMap.h"
 #include "../world/Footpath.h"
 #include "../world/Park.h"
+#include "../world/RidePresence.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Surface.h"
@@ -2120,6 +2122,9 @@ static void track_design_preview_restore_map(map_backup* backup)
     std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
     std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
     gNextFreeTileElement = backup->next_free_tile_element;
+    map_reset_free_tile_elements();
+    ride_presence_invalidate_all();
+    amenity_map_invalidate_all();
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
@@ -1547,6 +1547,7 @@ void Vehicle::UpdateMeasurements()
         curRide->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
         curRide->lifecycle_flags &= ~RIDE_LIFECYCLE_TEST_IN_PROGRESS;
         ClearUpdateFlag(VEHICLE_UPDATE_FLAG_TESTING);
+        ride_ratings_prioritise(ride);
         window_invalidate_by_number(WC_RIDE, ride);
         return;
     }
@@ -3045,6 +3046,7 @@ static void test_finish(Ride& ride)
 
     totalTime = std::max(totalTime, 1u);
     ride.average_speed = ride.average_speed / totalTime;
+    ride_ratings_prioritise(ride.id);
     window_invalidate_by_number(WC_RIDE, ride.id);
 }
 
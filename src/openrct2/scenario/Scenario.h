@@ -457,6 +457,13 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+
+/**
+ * Captures the park on the calling thread, then encodes and writes the file on a background thread. Failures are only
+ * logged, so this is meant for saves nobody waits on such as autosaves.
+ */
+void scenario_save_async(const utf8* path, int32_t flags);
+void scenario_wait_for_pending_save();
 void scenario_remove_trackless_rides(rct_s6_data* s6);
 void scenario_fix_ghosts(rct_s6_data* s6);
 void scenario_failure();
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../TickProfiler.h"
+#    include "Duktape.hpp"
+#    include "ScriptEngine.h"
+
+namespace OpenRCT2::Scripting
+{
+    class ScProfiler
+    {
+    private:
+        duk_context* _ctx{};
+
+    public:
+        ScProfiler(duk_context* ctx)
+            : _ctx(ctx)
+        {
+        }
+
+    private:
+        bool enabled_get() const
+        {
+            return TickProfiler::IsEnabled();
+        }
+
+        void start()
+        {
+            TickProfiler::SetEnabled(true);
+        }
+
+        void stop()
+        {
+            TickProfiler::SetEnabled(false);
+        }
+
+        void reset()
+        {
+            TickProfiler::Reset();
+        }
+
+        double ticks_get() const
+        {
+            return static_cast<double>(TickProfiler::GetTickCount());
+        }
+
+        std::vector<DukValue> getData() const
+        {
+            std::vector<DukValue> result;
+            for (const auto& stats : TickProfiler::GetStageStats())
+            {
+                DukObject stage(_ctx);
+                stage.Set("name", std::string_view(stats.Name));
+                stage.Set("samples", static_cast<double>(stats.Samples));
+                stage.Set("mean", stats.Mean);
+                stage.Set("p50", stats.P50);
+                stage.Set("p99", stats.P99);
+                stage.Set("max", stats.Max);
+                result.push_back(stage.Take());
+            }
+            return result;
+        }
+
+        DukValue getEntityCounts() const
+        {
+            DukObject result(_ctx);
+            for (const auto& entityCount : TickProfiler::GetEntityCounts())
+            {
+                result.Set(entityCount.Name, entityCount.Count);
+            }
+            return result.Take();
+        }
+
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_property(ctx, &ScProfiler::enabled_get, nullptr, "enabled");
+            dukglue_register_property(ctx, &ScProfiler::ticks_get, nullptr, "ticks");
+            dukglue_register_method(ctx, &ScProfiler::start, "start");
+            dukglue_register_method(ctx, &ScProfiler::stop, "stop");
+            dukglue_register_method(ctx, &ScProfiler::reset, "reset");
+            dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getEntityCounts, "getEntityCounts");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -14,7 +14,10 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../core/Guard.hpp"
+#    include "../peep/FootpathGraph.h"
+#    include "../world/AmenityMap.h"
 #    include "../world/Footpath.h"
+#    include "../world/RidePresence.h"
 #    include "../world/Scenery.h"
 #    include "../world/Sprite.h"
 #    include "../world/Surface.h"
@@ -98,6 +101,7 @@ namespace OpenRCT2::Scripting
             }
 
             _element->type = type;
+            footpath_graph_invalidate();
             Invalidate();
         }
 
@@ -993,6 +997,9 @@ namespace OpenRCT2::Scripting
         void Invalidate()
         {
             map_invalidate_tile_full(_coords);
+            ride_presence_invalidate_tile(_coords);
+            amenity_map_invalidate_tile(_coords);
+            footpath_graph_invalidate_tile(_coords);
         }
 
     public:
@@ -1176,6 +1183,9 @@ namespace OpenRCT2::Scripting
                     }
                 }
                 map_invalidate_tile_full(_coords);
+                ride_presence_invalidate_tile(_coords);
+                amenity_map_invalidate_tile(_coords);
+                footpath_graph_invalidate();
             }
         }
 
@@ -1247,6 +1257,7 @@ namespace OpenRCT2::Scripting
             {
                 tile_element_remove(&first[index]);
                 map_invalidate_tile_full(_coords);
+                amenity_map_invalidate_tile(_coords);
             }
         }
 
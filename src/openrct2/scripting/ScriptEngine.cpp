@@ -32,6 +32,7 @@
 #    include "ScNetwork.hpp"
 #    include "ScObject.hpp"
 #    include "ScPark.hpp"
+#    include "ScProfiler.hpp"
 #    include "ScRide.hpp"
 #    include "ScScenario.hpp"
 #    include "ScSocket.hpp"
@@ -43,7 +44,7 @@
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
-static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 7;
+static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 8;
 
 struct ExpressionStringifier final
 {
@@ -385,6 +386,7 @@ void ScriptEngine::Initialise()
     ScParkMessage::Register(ctx);
     ScPlayer::Register(ctx);
     ScPlayerGroup::Register(ctx);
+    ScProfiler::Register(ctx);
     ScRide::Register(ctx);
     ScRideStation::Register(ctx);
     ScRideObject::Register(ctx);
@@ -410,6 +412,7 @@ void ScriptEngine::Initialise()
     dukglue_register_global(ctx, std::make_shared<ScMap>(ctx), "map");
     dukglue_register_global(ctx, std::make_shared<ScNetwork>(ctx), "network");
     dukglue_register_global(ctx, std::make_shared<ScPark>(), "park");
+    dukglue_register_global(ctx, std::make_shared<ScProfiler>(ctx), "profiler");
     dukglue_register_global(ctx, std::make_shared<ScScenario>(), "scenario");
 
     _initialised = true;
@@ -16,6 +16,11 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define SAWYERCODING_SSE2
+#    include <emmintrin.h>
+#endif
+
 static size_t decode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length, size_t dstSize);
 
@@ -23,8 +28,6 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
 static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length);
 static void encode_chunk_rotate(uint8_t* buffer, size_t length);
 
-bool gUseRLE = true;
-
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 {
     size_t i;
@@ -42,15 +45,8 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
  */
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer, sawyercoding_chunk_header chunkHeader)
 {
-    uint8_t *encode_buffer, *encode_buffer2;
+    uint8_t* encode_buffer;
 
-    if (!gUseRLE)
-    {
-        if (chunkHeader.encoding == CHUNK_ENCODING_RLE || chunkHeader.encoding == CHUNK_ENCODING_RLECOMPRESSED)
-        {
-            chunkHeader.encoding = CHUNK_ENCODING_NONE;
-        }
-    }
     switch (chunkHeader.encoding)
     {
         case CHUNK_ENCODING_NONE:
@@ -61,24 +57,18 @@ size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer,
             // fwrite(buffer, 1, chunkHeader.length, file);
             break;
         case CHUNK_ENCODING_RLE:
-            encode_buffer = static_cast<uint8_t*>(malloc(0x600000));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(buffer, encode_buffer, chunkHeader.length));
+            // Encode straight into the destination, the header is written once the length is known
+            chunkHeader.length = static_cast<uint32_t>(
+                encode_chunk_rle(buffer, dst_file + sizeof(sawyercoding_chunk_header), chunkHeader.length));
             std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-            free(encode_buffer);
             break;
         case CHUNK_ENCODING_RLECOMPRESSED:
             encode_buffer = static_cast<uint8_t*>(malloc(chunkHeader.length * 2));
-            encode_buffer2 = static_cast<uint8_t*>(malloc(0x600000));
             chunkHeader.length = static_cast<uint32_t>(encode_chunk_repeat(buffer, encode_buffer, chunkHeader.length));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(encode_buffer, encode_buffer2, chunkHeader.length));
+            chunkHeader.length = static_cast<uint32_t>(
+                encode_chunk_rle(encode_buffer, dst_file + sizeof(sawyercoding_chunk_header), chunkHeader.length));
             std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer2, chunkHeader.length);
 
-            free(encode_buffer2);
             free(encode_buffer);
             break;
         case CHUNK_ENCODING_ROTATE:
@@ -248,7 +238,15 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
         {
             assert(dst + rleCodeByte + 1 <= dst_buffer + dstSize);
             assert(i + 1 < length);
-            std::memcpy(dst, src_buffer + i + 1, rleCodeByte + 1);
+            // Most literals are short, copy those with a single fixed size copy when both buffers have room for it
+            if (rleCodeByte < 16 && i + 1 + 16 <= length && dst + 16 <= dst_buffer + dstSize)
+            {
+                std::memcpy(dst, src_buffer + i + 1, 16);
+            }
+            else
+            {
+                std::memcpy(dst, src_buffer + i + 1, rleCodeByte + 1);
+            }
             dst = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(dst) + rleCodeByte + 1);
             i += rleCodeByte + 1;
         }
@@ -262,6 +260,125 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
 
 #pragma region Encoding
 
+/**
+ * Returns the index of the first byte in [0, limit) that is equal to the byte after it, or limit if there is none.
+ * src[limit] must be readable.
+ */
+static size_t find_repeated_byte(const uint8_t* src, size_t limit)
+{
+    size_t i = 0;
+#ifdef SAWYERCODING_SSE2
+    for (; i + 16 <= limit; i += 16)
+    {
+        auto current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1));
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(current, next));
+        if (mask != 0)
+        {
+            return i + bitscanforward(mask);
+        }
+    }
+#endif
+    for (; i < limit; i++)
+    {
+        if (src[i] == src[i + 1])
+            break;
+    }
+    return i;
+}
+
+/**
+ * Returns the number of leading bytes equal to src[0], at most limit.
+ */
+static size_t get_run_length(const uint8_t* src, size_t limit)
+{
+    size_t i = 1;
+#ifdef SAWYERCODING_SSE2
+    auto value = _mm_set1_epi8(static_cast<char>(src[0]));
+    for (; i + 16 <= limit; i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, value)) ^ 0xFFFF;
+        if (mask != 0)
+        {
+            return i + bitscanforward(mask);
+        }
+    }
+#endif
+    for (; i < limit; i++)
+    {
+        if (src[i] != src[0])
+            break;
+    }
+    return i;
+}
+
+/**
+ * Returns a mask of the bytes in src[0, length) that are equal to value, length must be at most 32.
+ */
+static uint32_t find_byte_mask(const uint8_t* src, uint8_t value, size_t length)
+{
+#ifdef SAWYERCODING_SSE2
+    if (length == 32)
+    {
+        auto values = _mm_set1_epi8(static_cast<char>(value));
+        auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        auto maskLo = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lo, values)));
+        auto maskHi = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(hi, values)));
+        return maskLo | (maskHi << 16);
+    }
+#endif
+    uint32_t mask = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (src[i] == value)
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+/**
+ * Returns the number of leading bytes that a and b have in common, at most limit which must be at most 8. If canReadWord
+ * is set, 8 bytes are readable from both a and b regardless of limit.
+ */
+static size_t get_match_length(const uint8_t* a, const uint8_t* b, size_t limit, bool canReadWord)
+{
+    if (canReadWord)
+    {
+        uint32_t a32[2];
+        uint32_t b32[2];
+        std::memcpy(a32, a, sizeof(a32));
+        std::memcpy(b32, b, sizeof(b32));
+        // The lowest set bit of the difference is in the first differing byte as the game is little endian only
+        uint32_t diff = a32[0] ^ b32[0];
+        size_t matching = 0;
+        if (diff == 0)
+        {
+            diff = a32[1] ^ b32[1];
+            matching = 4;
+        }
+        if (diff != 0)
+        {
+            matching += bitscanforward(static_cast<int32_t>(diff)) / 8;
+        }
+        else
+        {
+            matching = 8;
+        }
+        return std::min(matching, limit);
+    }
+
+    size_t matching = 0;
+    while (matching < limit && a[matching] == b[matching])
+    {
+        matching++;
+    }
+    return matching;
+}
+
 /**
  * Ensure dst_buffer is bigger than src_buffer then resize afterwards
  * returns length of dst_buffer
@@ -286,11 +403,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = static_cast<uint8_t>(get_run_length(src, std::min<size_t>(125, end_src - src)));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -299,8 +412,10 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         else
         {
-            count++;
-            src++;
+            // Extend the literal up to the next repeated byte, the maximum literal length or the last byte
+            auto literalLength = find_repeated_byte(src, std::min<size_t>(126 - count, end_src - 1 - src));
+            count += static_cast<uint8_t>(literalLength);
+            src += literalLength;
         }
     }
     if (src == end_src - 1)
@@ -332,26 +447,21 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
         size_t searchIndex = (i < 32) ? 0 : (i - 32);
         size_t searchEnd = i - 1;
 
+        // Only positions starting with the current byte can be repeated, so skip all others
+        uint32_t candidates = find_byte_mask(src_buffer + searchIndex, src_buffer[i], i - searchIndex);
+
         size_t bestRepeatIndex = 0;
         size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
+        while (candidates != 0)
         {
-            size_t repeatCount = 0;
+            size_t repeatIndex = searchIndex + bitscanforward(static_cast<int32_t>(candidates));
+            candidates &= candidates - 1;
+
             size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
             // maxRepeatCount should not exceed length
             assert(repeatIndex + maxRepeatCount < length);
             assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++)
-            {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j])
-                {
-                    repeatCount++;
-                }
-                else
-                {
-                    break;
-                }
-            }
+            size_t repeatCount = get_match_length(src_buffer + repeatIndex, src_buffer + i, maxRepeatCount + 1, i + 8 <= length);
             if (repeatCount > bestRepeatCount)
             {
                 bestRepeatIndex = repeatIndex;
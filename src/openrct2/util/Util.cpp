@@ -589,9 +589,10 @@ uint8_t* util_zlib_inflate(uint8_t* data, size_t data_in_size, size_t* data_out_
  * @brief Deflates input using zlib
  * @param data Data to be compressed
  * @param data_in_size Size of data to be compressed
+ * @param level Compression level from 0 to 9, or -1 for the zlib default
  * @return Returns an optional std::vector of bytes, which is equal to std::nullopt when deflate has failed
  */
-std::optional<std::vector<uint8_t>> util_zlib_deflate(const uint8_t* data, size_t data_in_size)
+std::optional<std::vector<uint8_t>> util_zlib_deflate(const uint8_t* data, size_t data_in_size, int32_t level)
 {
     int32_t ret = Z_OK;
     uLongf out_size = 0;
@@ -610,7 +611,7 @@ std::optional<std::vector<uint8_t>> util_zlib_deflate(const uint8_t* data, size_
             log_error("Your build is shipped with broken zlib. Please use the official build.");
             return std::nullopt;
         }
-        ret = compress(buffer.data(), &out_size, data, static_cast<uLong>(data_in_size));
+        ret = compress2(buffer.data(), &out_size, data, static_cast<uLong>(data_in_size), level);
     } while (ret != Z_OK);
     buffer.resize(out_size);
     return buffer;
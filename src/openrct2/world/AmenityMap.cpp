@@ -0,0 +1,263 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "AmenityMap.h"
+
+#include "Footpath.h"
+#include "Map.h"
+#include "Scenery.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <vector>
+
+static constexpr int32_t AMENITY_MAP_SIZE = MAXIMUM_MAP_SIZE_TECHNICAL;
+
+enum
+{
+    AMENITY_SCENERY,
+    AMENITY_FOUNTAINS,
+    AMENITY_BROKEN_PATH_ADDITIONS,
+    AMENITY_MISSING_PATH_ADDITIONS,
+};
+
+// Litter on the first coordinate of a tile along an axis is within reach of guests one tile further away.
+enum
+{
+    AMENITY_LITTER,
+    AMENITY_LITTER_AT_TILE_START_X,
+    AMENITY_LITTER_AT_TILE_START_Y,
+    AMENITY_LITTER_AT_TILE_START_XY,
+};
+
+using AmenityCounters = std::array<uint32_t, 4>;
+// Element i of a row holds the sum of the counters of tiles 0 to i - 1 of that row.
+using AmenityRow = std::array<AmenityCounters, AMENITY_MAP_SIZE + 1>;
+
+static std::array<AmenityRow, AMENITY_MAP_SIZE> _amenityElementRows;
+static std::array<AmenityRow, AMENITY_MAP_SIZE> _amenityLitterRows;
+static std::vector<TileCoordsXY> _amenityInvalidatedTiles;
+static std::bitset<AMENITY_MAP_SIZE * AMENITY_MAP_SIZE> _amenityInvalidatedTileFlags;
+static bool _amenityAllInvalidated = true;
+
+static AmenityCounters amenity_map_get_tile(const AmenityRow& row, int32_t x)
+{
+    AmenityCounters result;
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        result[i] = row[x + 1][i] - row[x][i];
+    }
+    return result;
+}
+
+static void amenity_map_add_to_tile(AmenityRow& row, int32_t x, const AmenityCounters& delta)
+{
+    for (int32_t i = x + 1; i <= AMENITY_MAP_SIZE; i++)
+    {
+        for (size_t j = 0; j < delta.size(); j++)
+        {
+            row[i][j] += delta[j];
+        }
+    }
+}
+
+static AmenityCounters amenity_map_count_tile(const TileCoordsXY& loc)
+{
+    AmenityCounters result{};
+    auto tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return result;
+
+    do
+    {
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_PATH:
+            {
+                auto pathElement = tileElement->AsPath();
+                if (!pathElement->HasAddition())
+                    break;
+
+                auto scenery = pathElement->GetAdditionEntry();
+                if (scenery == nullptr)
+                {
+                    result[AMENITY_MISSING_PATH_ADDITIONS]++;
+                    break;
+                }
+                if (pathElement->AdditionIsGhost())
+                    break;
+
+                if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
+                {
+                    result[AMENITY_FOUNTAINS]++;
+                    break;
+                }
+                if (pathElement->IsBroken())
+                {
+                    result[AMENITY_BROKEN_PATH_ADDITIONS]++;
+                }
+                break;
+            }
+            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                result[AMENITY_SCENERY]++;
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return result;
+}
+
+static void amenity_map_update()
+{
+    if (_amenityAllInvalidated)
+    {
+        for (int32_t y = 0; y < AMENITY_MAP_SIZE; y++)
+        {
+            auto& row = _amenityElementRows[y];
+            row[0] = {};
+            for (int32_t x = 0; x < AMENITY_MAP_SIZE; x++)
+            {
+                auto counters = amenity_map_count_tile({ x, y });
+                for (size_t i = 0; i < counters.size(); i++)
+                {
+                    row[x + 1][i] = row[x][i] + counters[i];
+                }
+            }
+        }
+        _amenityAllInvalidated = false;
+    }
+    else
+    {
+        for (const auto& tileLoc : _amenityInvalidatedTiles)
+        {
+            auto& row = _amenityElementRows[tileLoc.y];
+            auto oldCounters = amenity_map_get_tile(row, tileLoc.x);
+            auto newCounters = amenity_map_count_tile(tileLoc);
+            if (newCounters != oldCounters)
+            {
+                AmenityCounters delta;
+                for (size_t i = 0; i < delta.size(); i++)
+                {
+                    delta[i] = newCounters[i] - oldCounters[i];
+                }
+                amenity_map_add_to_tile(row, tileLoc.x, delta);
+            }
+        }
+    }
+    _amenityInvalidatedTiles.clear();
+    _amenityInvalidatedTileFlags.reset();
+}
+
+void amenity_map_invalidate_all()
+{
+    _amenityAllInvalidated = true;
+}
+
+void amenity_map_invalidate_tile(const CoordsXY& loc)
+{
+    if (_amenityAllInvalidated || !map_is_location_valid(loc))
+        return;
+
+    auto tileLoc = TileCoordsXY(loc);
+    auto flagIndex = tileLoc.y * AMENITY_MAP_SIZE + tileLoc.x;
+    if (!_amenityInvalidatedTileFlags[flagIndex])
+    {
+        _amenityInvalidatedTileFlags[flagIndex] = true;
+        _amenityInvalidatedTiles.push_back(tileLoc);
+    }
+}
+
+void amenity_map_reset_litter()
+{
+    for (auto& row : _amenityLitterRows)
+    {
+        row.fill({});
+    }
+}
+
+static void amenity_map_add_litter_amount(const CoordsXY& loc, uint32_t amount)
+{
+    if (!map_is_location_valid(loc))
+        return;
+
+    auto tileLoc = TileCoordsXY(loc);
+    auto atTileStartX = (loc.x % COORDS_XY_STEP) == 0;
+    auto atTileStartY = (loc.y % COORDS_XY_STEP) == 0;
+
+    AmenityCounters delta{};
+    delta[AMENITY_LITTER] = amount;
+    delta[AMENITY_LITTER_AT_TILE_START_X] = atTileStartX ? amount : 0;
+    delta[AMENITY_LITTER_AT_TILE_START_Y] = atTileStartY ? amount : 0;
+    delta[AMENITY_LITTER_AT_TILE_START_XY] = (atTileStartX && atTileStartY) ? amount : 0;
+    amenity_map_add_to_tile(_amenityLitterRows[tileLoc.y], tileLoc.x, delta);
+}
+
+void amenity_map_add_litter(const CoordsXY& loc)
+{
+    amenity_map_add_litter_amount(loc, 1);
+}
+
+void amenity_map_remove_litter(const CoordsXY& loc)
+{
+    // Adding the two's complement of one takes one away from each counter.
+    amenity_map_add_litter_amount(loc, UINT32_MAX);
+}
+
+AmenityCounts amenity_map_get_near(const CoordsXY& centre, int32_t radius)
+{
+    amenity_map_update();
+
+    auto centreTile = TileCoordsXY(centre);
+    auto tileRadius = radius / COORDS_XY_STEP;
+    auto left = std::max(centreTile.x - tileRadius, 0);
+    auto top = std::max(centreTile.y - tileRadius, 0);
+    auto right = std::min(centreTile.x + tileRadius - 1, AMENITY_MAP_SIZE - 1);
+    auto bottom = std::min(centreTile.y + tileRadius - 1, AMENITY_MAP_SIZE - 1);
+    auto edgeX = centreTile.x + tileRadius;
+    auto edgeY = centreTile.y + tileRadius;
+
+    AmenityCounters elements{};
+    uint32_t litter = 0;
+    if (left <= right)
+    {
+        for (auto y = top; y <= bottom; y++)
+        {
+            const auto& elementRow = _amenityElementRows[y];
+            const auto& litterRow = _amenityLitterRows[y];
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                elements[i] += elementRow[right + 1][i] - elementRow[left][i];
+            }
+            litter += litterRow[right + 1][AMENITY_LITTER] - litterRow[left][AMENITY_LITTER];
+            if (edgeX < AMENITY_MAP_SIZE)
+            {
+                litter += amenity_map_get_tile(litterRow, edgeX)[AMENITY_LITTER_AT_TILE_START_X];
+            }
+        }
+        if (edgeY < AMENITY_MAP_SIZE)
+        {
+            const auto& litterRow = _amenityLitterRows[edgeY];
+            litter += litterRow[right + 1][AMENITY_LITTER_AT_TILE_START_Y]
+                - litterRow[left][AMENITY_LITTER_AT_TILE_START_Y];
+            if (edgeX < AMENITY_MAP_SIZE)
+            {
+                litter += amenity_map_get_tile(litterRow, edgeX)[AMENITY_LITTER_AT_TILE_START_XY];
+            }
+        }
+    }
+
+    // Truncated like the 16 bit counters that used to be incremented while walking the area.
+    AmenityCounts result;
+    result.Scenery = static_cast<uint16_t>(elements[AMENITY_SCENERY]);
+    result.Fountains = static_cast<uint16_t>(elements[AMENITY_FOUNTAINS]);
+    result.Rubbish = static_cast<uint16_t>(elements[AMENITY_BROKEN_PATH_ADDITIONS] + litter);
+    result.HasMissingPathAdditions = elements[AMENITY_MISSING_PATH_ADDITIONS] != 0;
+    return result;
+}
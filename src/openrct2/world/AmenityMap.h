@@ -0,0 +1,42 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+struct AmenityCounts
+{
+    uint16_t Scenery;
+    uint16_t Fountains;
+    // Broken path additions and litter.
+    uint16_t Rubbish;
+    // Whether any path addition refers to an object that is not loaded.
+    bool HasMissingPathAdditions;
+};
+
+/**
+ * Per tile counts of the things guests look at when assessing their surroundings, kept as prefix sums along each map
+ * row so that counting them around a guest costs one lookup per row. Tile counts are recounted lazily after a tile has
+ * been invalidated; litter is tracked as it is created, moved and removed.
+ */
+void amenity_map_invalidate_all();
+void amenity_map_invalidate_tile(const CoordsXY& loc);
+
+void amenity_map_reset_litter();
+void amenity_map_add_litter(const CoordsXY& loc);
+void amenity_map_remove_litter(const CoordsXY& loc);
+
+/**
+ * Counts the amenities of the tiles starting from centre - radius up to but excluding centre + radius along both axes,
+ * and the litter no more than radius away from centre along either axis. Both centre and radius must be aligned to the
+ * tile grid.
+ */
+AmenityCounts amenity_map_get_near(const CoordsXY& centre, int32_t radius);
@@ -23,6 +23,7 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -1672,15 +1673,32 @@ static TileElement* footpath_can_be_wide(const CoordsXYZ& footpathPos)
     return nullptr;
 }
 
+// Returns the wide flags of the first 32 paths on a tile, one per bit.
+static uint32_t footpath_get_wide_flags(const CoordsXY& footpathPos)
+{
+    uint32_t wideFlags = 0;
+    TileElement* tileElement = map_get_first_element_at(footpathPos);
+    if (tileElement == nullptr)
+        return wideFlags;
+
+    uint32_t pathIndex = 0;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (pathIndex < 32 && tileElement->AsPath()->IsWide())
+            wideFlags |= 1u << pathIndex;
+        pathIndex++;
+    } while (!(tileElement++)->IsLastForTile());
+    return wideFlags;
+}
+
 /**
  *
  *  rct2: 0x006A87BB
  */
-void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
+static void footpath_update_path_wide_flags_at(const CoordsXY& footpathPos)
 {
-    if (map_is_location_at_edge(footpathPos))
-        return;
-
     footpath_clear_wide(footpathPos);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1861,6 +1879,20 @@ void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+void footpath_update_path_wide_flags(const CoordsXY& footpathPos)
+{
+    if (map_is_location_at_edge(footpathPos))
+        return;
+
+    // Guests do not walk through wide paths, so the footpath graph changes along with the flags.
+    auto oldWideFlags = footpath_get_wide_flags(footpathPos);
+    footpath_update_path_wide_flags_at(footpathPos);
+    if (footpath_get_wide_flags(footpathPos) != oldWideFlags)
+    {
+        footpath_graph_invalidate();
+    }
+}
+
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
 {
     auto pathElement = map_get_path_element_at(position);
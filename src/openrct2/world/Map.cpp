@@ -36,6 +36,7 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -43,12 +44,14 @@
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
+#include "AmenityMap.h"
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
 #include "Park.h"
+#include "RidePresence.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Surface.h"
@@ -56,8 +59,10 @@
 #include "Wall.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -107,6 +112,19 @@ std::vector<PeepSpawn> gPeepSpawns;
 TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
+struct FreeTileElementRun
+{
+    TileElement* Start;
+    uint32_t Length;
+};
+
+// Runs of tile elements that were vacated by tile_element_insert and tile_element_remove, bucketed by
+// length. The last bucket holds all runs of that length or longer. Reusing these delays the need to
+// defragment the whole element array with map_reorganise_elements.
+static constexpr uint32_t FREE_TILE_ELEMENT_RUN_CLASSES = 16;
+static std::array<std::vector<FreeTileElementRun>, FREE_TILE_ELEMENT_RUN_CLASSES + 1> _freeTileElementRuns;
+static uint32_t _numFreeTileElementsInRuns;
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -385,6 +403,11 @@ void map_update_tile_pointers()
 {
     int32_t i, x, y;
 
+    map_reset_free_tile_elements();
+    ride_presence_invalidate_all();
+    amenity_map_invalidate_all();
+    footpath_graph_invalidate();
+
     for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
     {
         gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
@@ -937,12 +960,31 @@ bool map_is_location_at_edge(const CoordsXY& loc)
     return loc.x < 32 || loc.y < 32 || loc.x >= (MAXIMUM_TILE_START_XY) || loc.y >= (MAXIMUM_TILE_START_XY);
 }
 
+static void free_tile_elements(TileElement* start, uint32_t length);
+
 /**
  *
  *  rct2: 0x0068B280
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+    {
+        ride_presence_invalidate_ride(tileElement->AsTrack()->GetRideIndex());
+    }
+    if (!tileElement->IsGhost())
+    {
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_PATH:
+            case TILE_ELEMENT_TYPE_TRACK:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+            case TILE_ELEMENT_TYPE_BANNER:
+                footpath_graph_invalidate();
+                break;
+        }
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -958,10 +1000,7 @@ void tile_element_remove(TileElement* tileElement)
     (tileElement - 1)->SetLastForTile(true);
     tileElement->base_height = MAX_ELEMENT_HEIGHT;
 
-    if ((tileElement + 1) == gNextFreeTileElement)
-    {
-        gNextFreeTileElement--;
-    }
+    free_tile_elements(tileElement, 1);
 }
 
 /**
@@ -1120,18 +1159,16 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
     if (numElements != 0)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
-
-        // Check if is there is room for the required number of elements
-        auto newTileElementEnd = gNextFreeTileElement + numElements;
-        if (newTileElementEnd > tileElementEnd)
+        // Check if is there is room for the required number of elements, either at the end or in vacated runs which
+        // tile_element_insert will reuse. It defragments the map element list by itself should the runs turn out to be
+        // too fragmented.
+        if (map_get_num_free_tile_elements() < static_cast<uint32_t>(numElements))
         {
             // Defragment the map element list
             map_reorganise_elements();
 
             // Check if there is any room again
-            newTileElementEnd = gNextFreeTileElement + numElements;
-            if (newTileElementEnd > tileElementEnd)
+            if (map_get_num_free_tile_elements() < static_cast<uint32_t>(numElements))
             {
                 // Not enough spare elements left :'(
                 gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
@@ -1142,6 +1179,99 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
     return true;
 }
 
+static uint32_t get_free_tile_element_run_class(uint32_t length)
+{
+    return std::min(length, FREE_TILE_ELEMENT_RUN_CLASSES);
+}
+
+/**
+ * Forgets all vacated element runs, needs to be called whenever the element array is replaced or
+ * defragmented.
+ */
+void map_reset_free_tile_elements()
+{
+    for (auto& runs : _freeTileElementRuns)
+    {
+        runs.clear();
+    }
+    _numFreeTileElementsInRuns = 0;
+}
+
+/**
+ * Number of elements that can be inserted without defragmenting the element array, counting both the unused space at
+ * the end of the array and the vacated runs.
+ */
+uint32_t map_get_num_free_tile_elements()
+{
+    const auto* tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
+    const auto numAtEnd = gNextFreeTileElement < tileElementEnd ? static_cast<uint32_t>(tileElementEnd - gNextFreeTileElement)
+                                                                : 0;
+    return numAtEnd + _numFreeTileElementsInRuns;
+}
+
+/**
+ * Returns a run of vacated elements for reuse. The run must not belong to any tile anymore.
+ */
+static void free_tile_elements(TileElement* start, uint32_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    if (start + length == gNextFreeTileElement)
+    {
+        // Run is at the end of the used area, just give it back.
+        gNextFreeTileElement = start;
+        return;
+    }
+    _freeTileElementRuns[get_free_tile_element_run_class(length)].push_back({ start, length });
+    _numFreeTileElementsInRuns += length;
+}
+
+/**
+ * Finds room for a tile with the given number of elements, preferring a vacated run of the same
+ * length, then the smallest longer one, then unused space at the end of the element array.
+ */
+static TileElement* allocate_tile_elements(uint32_t length)
+{
+    for (uint32_t runClass = get_free_tile_element_run_class(length); runClass <= FREE_TILE_ELEMENT_RUN_CLASSES; runClass++)
+    {
+        auto& runs = _freeTileElementRuns[runClass];
+        for (auto it = runs.rbegin(); it != runs.rend(); it++)
+        {
+            auto run = *it;
+            if (run.Length < length)
+            {
+                // Only possible within the last class.
+                continue;
+            }
+            runs.erase(std::next(it).base());
+            _numFreeTileElementsInRuns -= length;
+
+            if (run.Length > length)
+            {
+                // Keep the remainder for smaller tiles.
+                auto remainderLength = run.Length - length;
+                _freeTileElementRuns[get_free_tile_element_run_class(remainderLength)].push_back(
+                    { run.Start + length, remainderLength });
+            }
+            return run.Start;
+        }
+    }
+
+    // As before, only the new element has to fit below MAX_TILE_ELEMENTS, the copy of the tile's existing elements may
+    // use the spare room behind it. This is what map_check_free_elements_and_reorganise checks for.
+    if (gNextFreeTileElement < &gTileElements[MAX_TILE_ELEMENTS]
+        && gNextFreeTileElement + length <= &gTileElements[MAX_TILE_ELEMENTS_WITH_SPARE_ROOM])
+    {
+        auto* start = gNextFreeTileElement;
+        gNextFreeTileElement += length;
+        return start;
+    }
+    return nullptr;
+}
+
 /**
  *
  *  rct2: 0x0068B1F6
@@ -1149,20 +1279,40 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
 TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants)
 {
     const auto& tileLoc = TileCoordsXYZ(loc);
+    const auto tileIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
     TileElement *originalTileElement, *newTileElement, *insertedElement;
     bool isLastForTile = false;
 
-    if (!map_check_free_elements_and_reorganise(1))
+    uint32_t numOriginalElements = 0;
+    if (gTileElementTilePointers[tileIndex] != nullptr)
     {
-        log_error("Cannot insert new element");
-        return nullptr;
+        for (auto* tileElement = gTileElementTilePointers[tileIndex];; tileElement++)
+        {
+            numOriginalElements++;
+            if (tileElement->IsLastForTile())
+                break;
+        }
+    }
+
+    newTileElement = allocate_tile_elements(numOriginalElements + 1);
+    if (newTileElement == nullptr)
+    {
+        // Neither the vacated runs nor the end of the array have room, only now defragment the element array.
+        map_reorganise_elements();
+        newTileElement = allocate_tile_elements(numOriginalElements + 1);
+        if (newTileElement == nullptr)
+        {
+            gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+            log_error("Cannot insert new element");
+            return nullptr;
+        }
     }
 
-    newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x];
+    originalTileElement = gTileElementTilePointers[tileIndex];
+    TileElement* const vacatedElements = originalTileElement;
 
     // Set tile index pointer to point to new element block
-    gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x] = newTileElement;
+    gTileElementTilePointers[tileIndex] = newTileElement;
 
     if (originalTileElement == nullptr)
     {
@@ -1214,7 +1364,11 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
         } while (!((newTileElement - 1)->IsLastForTile()));
     }
 
-    gNextFreeTileElement = newTileElement;
+    // The old location of the tile's elements can now be reused
+    free_tile_elements(vacatedElements, numOriginalElements);
+    ride_presence_invalidate_tile(loc);
+    amenity_map_invalidate_tile(loc);
+    footpath_graph_invalidate_tile(loc);
     return insertedElement;
 }
 
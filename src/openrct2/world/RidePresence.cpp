@@ -0,0 +1,164 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RidePresence.h"
+
+#include "Map.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// A guest searching 10 tiles around themselves touches at most 16 blocks of this size.
+static constexpr int32_t RIDE_PRESENCE_BLOCK_SIZE = 8;
+static constexpr int32_t RIDE_PRESENCE_BLOCKS = MAXIMUM_MAP_SIZE_TECHNICAL / RIDE_PRESENCE_BLOCK_SIZE;
+
+struct RidePresenceTile
+{
+    TileCoordsXY Location;
+    ride_id_t RideIndex;
+};
+
+struct RidePresenceBlock
+{
+    std::bitset<MAX_RIDES> Rides;
+    // Every ride on every tile of the block once, used when a search only covers part of the block.
+    std::vector<RidePresenceTile> Tiles;
+    bool Invalidated = true;
+};
+
+static std::array<RidePresenceBlock, RIDE_PRESENCE_BLOCKS * RIDE_PRESENCE_BLOCKS> _ridePresenceBlocks;
+static bool _ridePresenceAllInvalidated = true;
+
+void ride_presence_invalidate_all()
+{
+    _ridePresenceAllInvalidated = true;
+}
+
+void ride_presence_invalidate_tile(const CoordsXY& loc)
+{
+    if (map_is_location_valid(loc))
+    {
+        auto tileLoc = TileCoordsXY(loc);
+        auto blockIndex = (tileLoc.y / RIDE_PRESENCE_BLOCK_SIZE) * RIDE_PRESENCE_BLOCKS + tileLoc.x / RIDE_PRESENCE_BLOCK_SIZE;
+        _ridePresenceBlocks[blockIndex].Invalidated = true;
+    }
+}
+
+void ride_presence_invalidate_ride(ride_id_t rideIndex)
+{
+    if (rideIndex >= MAX_RIDES)
+    {
+        return;
+    }
+    for (auto& block : _ridePresenceBlocks)
+    {
+        if (block.Rides[rideIndex])
+        {
+            block.Invalidated = true;
+        }
+    }
+}
+
+static void ride_presence_update_block(RidePresenceBlock& block, int32_t blockX, int32_t blockY)
+{
+    block.Rides.reset();
+    block.Tiles.clear();
+    for (int32_t y = blockY * RIDE_PRESENCE_BLOCK_SIZE; y < (blockY + 1) * RIDE_PRESENCE_BLOCK_SIZE; y++)
+    {
+        for (int32_t x = blockX * RIDE_PRESENCE_BLOCK_SIZE; x < (blockX + 1) * RIDE_PRESENCE_BLOCK_SIZE; x++)
+        {
+            auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+
+            auto tileStart = block.Tiles.size();
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
+                    continue;
+
+                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                if (rideIndex >= MAX_RIDES)
+                    continue;
+
+                auto tileEnd = block.Tiles.end();
+                if (std::none_of(block.Tiles.begin() + tileStart, tileEnd, [rideIndex](const RidePresenceTile& tile) {
+                        return tile.RideIndex == rideIndex;
+                    }))
+                {
+                    block.Rides[rideIndex] = true;
+                    block.Tiles.push_back({ { x, y }, rideIndex });
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+    block.Invalidated = false;
+}
+
+std::bitset<MAX_RIDES> ride_presence_get_rides_near(const CoordsXY& loc, int32_t radius)
+{
+    auto centre = loc.ToTileStart();
+    return ride_presence_get_rides_in_range({ centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius });
+}
+
+std::bitset<MAX_RIDES> ride_presence_get_rides_in_range(const MapRange& range)
+{
+    if (_ridePresenceAllInvalidated)
+    {
+        for (auto& block : _ridePresenceBlocks)
+        {
+            block.Invalidated = true;
+        }
+        _ridePresenceAllInvalidated = false;
+    }
+
+    auto left = std::max(floor2(range.GetLeft(), COORDS_XY_STEP) / COORDS_XY_STEP, 0);
+    auto top = std::max(floor2(range.GetTop(), COORDS_XY_STEP) / COORDS_XY_STEP, 0);
+    auto right = std::min(floor2(range.GetRight(), COORDS_XY_STEP) / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    auto bottom = std::min(floor2(range.GetBottom(), COORDS_XY_STEP) / COORDS_XY_STEP, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+
+    std::bitset<MAX_RIDES> rides;
+    if (left > right || top > bottom)
+    {
+        return rides;
+    }
+
+    for (auto blockY = top / RIDE_PRESENCE_BLOCK_SIZE; blockY <= bottom / RIDE_PRESENCE_BLOCK_SIZE; blockY++)
+    {
+        for (auto blockX = left / RIDE_PRESENCE_BLOCK_SIZE; blockX <= right / RIDE_PRESENCE_BLOCK_SIZE; blockX++)
+        {
+            auto& block = _ridePresenceBlocks[blockY * RIDE_PRESENCE_BLOCKS + blockX];
+            if (block.Invalidated)
+            {
+                ride_presence_update_block(block, blockX, blockY);
+            }
+
+            auto blockLeft = blockX * RIDE_PRESENCE_BLOCK_SIZE;
+            auto blockTop = blockY * RIDE_PRESENCE_BLOCK_SIZE;
+            if (blockLeft >= left && blockLeft + RIDE_PRESENCE_BLOCK_SIZE - 1 <= right && blockTop >= top
+                && blockTop + RIDE_PRESENCE_BLOCK_SIZE - 1 <= bottom)
+            {
+                rides |= block.Rides;
+            }
+            else
+            {
+                for (const auto& tile : block.Tiles)
+                {
+                    if (tile.Location.x >= left && tile.Location.x <= right && tile.Location.y >= top
+                        && tile.Location.y <= bottom)
+                    {
+                        rides[tile.RideIndex] = true;
+                    }
+                }
+            }
+        }
+    }
+    return rides;
+}
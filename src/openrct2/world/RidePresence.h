@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../ride/Ride.h"
+#include "Location.hpp"
+
+#include <bitset>
+
+/**
+ * Coarse index of which rides have track pieces in each block of map tiles, so that guests looking for nearby rides
+ * do not have to walk every tile element around them. Blocks are rebuilt from the map lazily, after any of the
+ * functions below marked them as changed.
+ */
+void ride_presence_invalidate_all();
+void ride_presence_invalidate_tile(const CoordsXY& loc);
+void ride_presence_invalidate_ride(ride_id_t rideIndex);
+
+/**
+ * Returns the rides that have track on any valid tile within radius (in coordinates, along both axes) of the tile
+ * containing loc. This matches walking all tile elements of those tiles.
+ */
+std::bitset<MAX_RIDES> ride_presence_get_rides_near(const CoordsXY& loc, int32_t radius);
+
+/**
+ * Returns the rides that have track on any valid tile overlapping range, whose corners are both inclusive.
+ */
+std::bitset<MAX_RIDES> ride_presence_get_rides_in_range(const MapRange& range);
@@ -17,6 +17,7 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../ride/TrackDesign.h"
+#include "AmenityMap.h"
 #include "Footpath.h"
 #include "Map.h"
 #include "MapAnimation.h"
@@ -51,6 +52,7 @@ static int32_t map_place_clear_func(
         return 0;
 
     map_invalidate_tile({ coords, (*tile_element)->GetBaseZ(), (*tile_element)->GetClearanceZ() });
+    amenity_map_invalidate_tile(coords);
 
     tile_element_remove(*tile_element);
 
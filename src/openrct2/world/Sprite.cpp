@@ -15,15 +15,23 @@
 #include "../audio/audio.h"
 #include "../core/Crypt.h"
 #include "../core/Guard.hpp"
+#include "../core/Numerics.hpp"
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
 #include "../scenario/Scenario.h"
+#include "AmenityMap.h"
 #include "Fountain.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <xmmintrin.h>
+#endif
 
 uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
@@ -49,6 +57,18 @@ const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
 static CoordsXYZ _spritelocations1[MAX_SPRITES];
 static CoordsXYZ _spritelocations2[MAX_SPRITES];
 
+// Dense copy of each entity linked list, stored tail first so that a new head is appended at the back.
+// Iterating the linked lists is a chain of dependent loads across the sprite array, the copies let us
+// fetch the entities that are visited next ahead of time. The linked lists remain authoritative, a copy
+// that went out of sync is rebuilt the next time the list is iterated.
+// An entity leaving a list leaves a hole in the copy, the holes are squeezed out once they make up half
+// of it. Together with the position of every entity in its copy this keeps all updates constant time.
+static std::vector<uint16_t> _entityListOrder[static_cast<uint8_t>(EntityListId::Count)];
+static size_t _entityListOrderHoles[static_cast<uint8_t>(EntityListId::Count)];
+static bool _entityListOrderValid[static_cast<uint8_t>(EntityListId::Count)];
+static uint32_t _entityListOrderPosition[MAX_SPRITES];
+static constexpr size_t ENTITY_PREFETCH_DISTANCE = 4;
+
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
 static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex);
 
@@ -83,6 +103,209 @@ uint16_t GetEntityListCount(EntityListId list)
     return gSpriteListCount[static_cast<uint8_t>(list)];
 }
 
+void EntityListSortByOrder(EntityListId list, std::vector<uint16_t>& entityIds)
+{
+    std::vector<uint16_t> ordered;
+    ordered.reserve(entityIds.size());
+    uint16_t spriteIndex = gSpriteListHead[static_cast<uint8_t>(list)];
+    for (size_t i = 0; i < MAX_SPRITES && spriteIndex != SPRITE_INDEX_NULL && ordered.size() < entityIds.size(); i++)
+    {
+        if (std::find(entityIds.begin(), entityIds.end(), spriteIndex) != entityIds.end())
+        {
+            ordered.push_back(spriteIndex);
+        }
+        auto* entity = try_get_sprite(spriteIndex);
+        if (entity == nullptr)
+            break;
+        spriteIndex = entity->next;
+    }
+
+    // Only a broken list can miss some of them, keep those in their original order.
+    for (auto entityId : entityIds)
+    {
+        if (std::find(ordered.begin(), ordered.end(), entityId) == ordered.end())
+        {
+            ordered.push_back(entityId);
+        }
+    }
+    entityIds = std::move(ordered);
+}
+
+static void PrefetchEntity(uint16_t spriteIndex)
+{
+    // The sprite base and the start of the type specific data share the first two cache lines.
+    const auto* address = reinterpret_cast<const char*>(&_spriteList[spriteIndex]);
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+    __builtin_prefetch(address + 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(address, _MM_HINT_T0);
+    _mm_prefetch(address + 64, _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+static void EntityListOrderInvalidate()
+{
+    for (auto& valid : _entityListOrderValid)
+    {
+        valid = false;
+    }
+}
+
+static void EntityListOrderRebuild(EntityListId list)
+{
+    const auto listIndex = static_cast<uint8_t>(list);
+    auto& order = _entityListOrder[listIndex];
+    order.clear();
+    _entityListOrderHoles[listIndex] = 0;
+
+    for (uint16_t spriteIndex = gSpriteListHead[listIndex]; spriteIndex != SPRITE_INDEX_NULL;)
+    {
+        auto* entity = try_get_sprite(spriteIndex);
+        if (entity == nullptr || order.size() >= MAX_SPRITES)
+        {
+            // Broken or cyclic list, iterate without prefetching.
+            _entityListOrderValid[listIndex] = false;
+            return;
+        }
+        order.push_back(spriteIndex);
+        spriteIndex = entity->next;
+    }
+    std::reverse(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        _entityListOrderPosition[order[i]] = static_cast<uint32_t>(i);
+    }
+    _entityListOrderValid[listIndex] = true;
+}
+
+static void EntityListOrderCompact(uint8_t listIndex)
+{
+    auto& order = _entityListOrder[listIndex];
+    size_t count = 0;
+    for (auto spriteIndex : order)
+    {
+        if (spriteIndex != SPRITE_INDEX_NULL)
+        {
+            _entityListOrderPosition[spriteIndex] = static_cast<uint32_t>(count);
+            order[count++] = spriteIndex;
+        }
+    }
+    order.resize(count);
+    _entityListOrderHoles[listIndex] = 0;
+}
+
+/**
+ * Looks up the position of an entity in the copy of the given list.
+ * @return The position or SIZE_MAX if the entity is not in the copy.
+ */
+static size_t EntityListOrderFind(uint8_t listIndex, uint16_t spriteIndex)
+{
+    if (spriteIndex >= MAX_SPRITES)
+    {
+        return SIZE_MAX;
+    }
+    const auto& order = _entityListOrder[listIndex];
+    const size_t position = _entityListOrderPosition[spriteIndex];
+    if (position >= order.size() || order[position] != spriteIndex)
+    {
+        return SIZE_MAX;
+    }
+    return position;
+}
+
+static void EntityListOrderMove(uint16_t spriteIndex, EntityListId oldList, EntityListId newList)
+{
+    const auto oldListIndex = static_cast<uint8_t>(oldList);
+    if (_entityListOrderValid[oldListIndex])
+    {
+        const auto position = EntityListOrderFind(oldListIndex, spriteIndex);
+        if (position != SIZE_MAX)
+        {
+            auto& order = _entityListOrder[oldListIndex];
+            order[position] = SPRITE_INDEX_NULL;
+            _entityListOrderHoles[oldListIndex]++;
+            if (_entityListOrderHoles[oldListIndex] * 2 > order.size())
+            {
+                EntityListOrderCompact(oldListIndex);
+            }
+        }
+        else
+        {
+            _entityListOrderValid[oldListIndex] = false;
+        }
+    }
+
+    const auto newListIndex = static_cast<uint8_t>(newList);
+    if (_entityListOrderValid[newListIndex])
+    {
+        auto& order = _entityListOrder[newListIndex];
+        _entityListOrderPosition[spriteIndex] = static_cast<uint32_t>(order.size());
+        order.push_back(spriteIndex);
+    }
+}
+
+/**
+ * Prepares prefetching for a new iteration of the given list.
+ * @return The cursor to pass to EntityListPrefetch.
+ */
+size_t EntityListPrefetchBegin(EntityListId list)
+{
+    const auto listIndex = static_cast<uint8_t>(list);
+    if (!_entityListOrderValid[listIndex])
+    {
+        EntityListOrderRebuild(list);
+        if (!_entityListOrderValid[listIndex])
+        {
+            return 0;
+        }
+    }
+
+    const auto& order = _entityListOrder[listIndex];
+    const size_t count = std::min(order.size(), ENTITY_PREFETCH_DISTANCE);
+    for (size_t i = 1; i <= count; i++)
+    {
+        if (order[order.size() - i] != SPRITE_INDEX_NULL)
+        {
+            PrefetchEntity(order[order.size() - i]);
+        }
+    }
+    return order.size();
+}
+
+/**
+ * Called with each entity the list iterator is about to visit, prefetches the entity that will be
+ * visited a few steps later. Resynchronises the cursor if the list was modified during iteration.
+ */
+void EntityListPrefetch(EntityListId list, size_t& cursor, uint16_t entityId)
+{
+    const auto listIndex = static_cast<uint8_t>(list);
+    if (!_entityListOrderValid[listIndex])
+    {
+        return;
+    }
+
+    const auto& order = _entityListOrder[listIndex];
+    if (cursor == 0 || cursor > order.size() || order[cursor - 1] != entityId)
+    {
+        const auto position = EntityListOrderFind(listIndex, entityId);
+        if (position == SIZE_MAX)
+        {
+            _entityListOrderValid[listIndex] = false;
+            return;
+        }
+        cursor = position + 1;
+    }
+
+    cursor--;
+    if (cursor >= ENTITY_PREFETCH_DISTANCE && order[cursor - ENTITY_PREFETCH_DISTANCE] != SPRITE_INDEX_NULL)
+    {
+        PrefetchEntity(order[cursor - ENTITY_PREFETCH_DISTANCE]);
+    }
+}
+
 std::string rct_sprite_checksum::ToString() const
 {
     std::string result;
@@ -207,6 +430,7 @@ void reset_sprite_list()
 
     gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] = MAX_SPRITES;
 
+    EntityListOrderInvalidate();
     reset_sprite_spatial_index();
 }
 
@@ -218,7 +442,11 @@ void reset_sprite_list()
  */
 void reset_sprite_spatial_index()
 {
+    // Called after the sprites have been replaced wholesale, e.g. when loading a park.
+    EntityListOrderInvalidate();
+
     std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
+    amenity_map_reset_litter();
     for (size_t i = 0; i < MAX_SPRITES; i++)
     {
         auto* spr = GetEntity(i);
@@ -228,6 +456,11 @@ void reset_sprite_spatial_index()
             uint32_t nextSpriteId = gSpriteSpatialIndex[index];
             gSpriteSpatialIndex[index] = spr->sprite_index;
             spr->next_in_quadrant = nextSpriteId;
+
+            if (spr->Is<Litter>())
+            {
+                amenity_map_add_litter({ spr->x, spr->y });
+            }
         }
     }
 }
@@ -254,6 +487,49 @@ static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
 
 #ifndef DISABLE_NETWORK
 
+/**
+ * Copies the entity into a full rct_sprite with all state that is irrelevant to the game or differs between clients
+ * cleared, so that it can be hashed.
+ */
+static void sprite_checksum_copy(const SpriteBase* sprite, rct_sprite& copy)
+{
+    // Upconvert it to rct_sprite so that the full size is copied.
+    copy = *reinterpret_cast<const rct_sprite*>(sprite);
+
+    // Only required for rendering/invalidation, has no meaning to the game state.
+    copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
+    copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
+
+    // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
+    while (copy.generic.next_in_quadrant < MAX_SPRITES)
+    {
+        const auto& nextSprite = _spriteList[copy.generic.next_in_quadrant].generic;
+        if (nextSprite.sprite_identifier == SPRITE_IDENTIFIER_MISC)
+        {
+            copy.generic.next_in_quadrant = nextSprite.next_in_quadrant;
+        }
+        else
+            break;
+    }
+
+    if (copy.generic.Is<Peep>())
+    {
+        // Name is pointer and will not be the same across clients
+        copy.peep.Name = {};
+
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
+        // game state.
+        copy.peep.WindowInvalidateFlags = 0;
+    }
+}
+
+static bool sprite_checksum_includes(const SpriteBase* sprite)
+{
+    return sprite != nullptr && sprite->sprite_identifier != SPRITE_IDENTIFIER_NULL
+        && sprite->sprite_identifier != SPRITE_IDENTIFIER_MISC;
+}
+
 rct_sprite_checksum sprite_checksum()
 {
     using namespace Crypt;
@@ -276,50 +552,117 @@ rct_sprite_checksum sprite_checksum()
         {
             // TODO create a way to copy only the specific type
             auto sprite = GetEntity(i);
-            if (sprite != nullptr && sprite->sprite_identifier != SPRITE_IDENTIFIER_NULL
-                && sprite->sprite_identifier != SPRITE_IDENTIFIER_MISC)
+            if (sprite_checksum_includes(sprite))
             {
-                // Upconvert it to rct_sprite so that the full size is copied.
-                auto copy = *reinterpret_cast<rct_sprite*>(sprite);
+                rct_sprite copy;
+                sprite_checksum_copy(sprite, copy);
+                _spriteHashAlg->Update(&copy, sizeof(copy));
+            }
+        }
 
-                // Only required for rendering/invalidation, has no meaning to the game state.
-                copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
-                copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
+        checksum.raw = _spriteHashAlg->Finish();
+    }
+    catch (std::exception& e)
+    {
+        log_error("sprite_checksum failed: %s", e.what());
+        throw;
+    }
 
-                // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
-                while (auto* nextSprite = GetEntity(copy.generic.next_in_quadrant))
+    return checksum;
+}
+
+// Leaf hashes of each entity slot and the group hashes built from them, kept between calls so that only groups
+// containing a changed entity need to be combined again.
+static std::array<uint64_t, MAX_SPRITES> _spriteChecksumLeaves;
+static std::array<uint64_t, SPRITE_CHECKSUM_GROUP_COUNT> _spriteChecksumGroups;
+static bool _spriteChecksumGroupsValid;
+
+static uint64_t sprite_checksum_hash(const void* data, size_t length, uint64_t seed)
+{
+    // Multiply-rotate hash over 64-bit words, only has to detect divergence and is far cheaper than SHA1.
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed ^ Prime1;
+    for (size_t i = 0; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash ^= Numerics::rol(word * Prime2, 31) * Prime1;
+        hash = Numerics::rol(hash, 27) * Prime1 + Prime2;
+    }
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+static_assert(sizeof(rct_sprite) % sizeof(uint64_t) == 0);
+
+rct_sprite_checksum sprite_checksum_root()
+{
+    using namespace Crypt;
+
+    static std::unique_ptr<HashAlgorithm<20>> _rootHashAlg;
+
+    rct_sprite_checksum checksum;
+
+    try
+    {
+        if (_rootHashAlg == nullptr)
+        {
+            _rootHashAlg = CreateSHA1();
+        }
+
+        // Entities are modified through plain field writes everywhere, so every leaf is recomputed and compared with the
+        // cached one. Only combining the group hashes is skipped for groups that did not change.
+        for (size_t group = 0; group < SPRITE_CHECKSUM_GROUP_COUNT; group++)
+        {
+            auto first = group * SPRITE_CHECKSUM_GROUP_SIZE;
+            auto last = std::min<size_t>(first + SPRITE_CHECKSUM_GROUP_SIZE, MAX_SPRITES);
+            bool changed = !_spriteChecksumGroupsValid;
+            for (size_t i = first; i < last; i++)
+            {
+                uint64_t leaf = 0;
+                auto sprite = GetEntity(i);
+                if (sprite_checksum_includes(sprite))
                 {
-                    if (nextSprite->sprite_identifier == SPRITE_IDENTIFIER_MISC)
-                        copy.generic.next_in_quadrant = nextSprite->next_in_quadrant;
-                    else
-                        break;
+                    rct_sprite copy;
+                    sprite_checksum_copy(sprite, copy);
+                    leaf = sprite_checksum_hash(&copy, sizeof(copy), i);
                 }
-
-                if (copy.generic.Is<Peep>())
+                if (_spriteChecksumLeaves[i] != leaf)
                 {
-                    // Name is pointer and will not be the same across clients
-                    copy.peep.Name = {};
-
-                    // We set this to 0 because as soon the client selects a guest the window will remove the
-                    // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
-                    // game state.
-                    copy.peep.WindowInvalidateFlags = 0;
+                    _spriteChecksumLeaves[i] = leaf;
+                    changed = true;
                 }
-
-                _spriteHashAlg->Update(&copy, sizeof(copy));
+            }
+            if (changed)
+            {
+                _spriteChecksumGroups[group] = sprite_checksum_hash(
+                    &_spriteChecksumLeaves[first], (last - first) * sizeof(uint64_t), group);
             }
         }
+        _spriteChecksumGroupsValid = true;
 
-        checksum.raw = _spriteHashAlg->Finish();
+        _rootHashAlg->Clear();
+        _rootHashAlg->Update(_spriteChecksumGroups.data(), sizeof(_spriteChecksumGroups));
+        checksum.raw = _rootHashAlg->Finish();
     }
     catch (std::exception& e)
     {
-        log_error("sprite_checksum failed: %s", e.what());
+        log_error("sprite_checksum_root failed: %s", e.what());
         throw;
     }
 
     return checksum;
 }
+
+const std::array<uint64_t, SPRITE_CHECKSUM_GROUP_COUNT>& sprite_checksum_groups()
+{
+    return _spriteChecksumGroups;
+}
 #else
 
 rct_sprite_checksum sprite_checksum()
@@ -327,6 +670,17 @@ rct_sprite_checksum sprite_checksum()
     return rct_sprite_checksum{};
 }
 
+rct_sprite_checksum sprite_checksum_root()
+{
+    return rct_sprite_checksum{};
+}
+
+const std::array<uint64_t, SPRITE_CHECKSUM_GROUP_COUNT>& sprite_checksum_groups()
+{
+    static std::array<uint64_t, SPRITE_CHECKSUM_GROUP_COUNT> groups{};
+    return groups;
+}
+
 #endif // DISABLE_NETWORK
 
 static void sprite_reset(SpriteBase* sprite)
@@ -519,6 +873,8 @@ static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex)
     // Decrement old list counter, increment new list counter.
     gSpriteListCount[static_cast<uint8_t>(oldListIndex)]--;
     gSpriteListCount[static_cast<uint8_t>(newListIndex)]++;
+
+    EntityListOrderMove(sprite->sprite_index, oldListIndex, newListIndex);
 }
 
 /**
@@ -731,6 +1087,12 @@ void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
 
     SpriteSpatialMove(this, loc);
 
+    if (Is<Litter>())
+    {
+        amenity_map_remove_litter({ x, y });
+        amenity_map_add_litter(loc);
+    }
+
     if (loc.x == LOCATION_NULL)
     {
         sprite_left = LOCATION_NULL;
@@ -769,6 +1131,11 @@ void sprite_remove(SpriteBase* sprite)
         peep->SetName({});
     }
 
+    if (sprite->Is<Litter>())
+    {
+        amenity_map_remove_litter({ sprite->x, sprite->y });
+    }
+
     move_sprite_to_list(sprite, EntityListId::Free);
     sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->sprite_index] = false;
@@ -1061,6 +1428,10 @@ static bool index_is_in_list(uint16_t index, EntityListId sl)
 
 int32_t check_for_sprite_list_cycles(bool fix)
 {
+    if (fix)
+    {
+        EntityListOrderInvalidate();
+    }
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
     {
         auto* cycle_start = find_sprite_list_cycle(gSpriteListHead[i]);
@@ -1114,6 +1485,8 @@ int32_t check_for_sprite_list_cycles(bool fix)
  */
 int32_t fix_disjoint_sprites()
 {
+    _entityListOrderValid[static_cast<uint8_t>(EntityListId::Free)] = false;
+
     // Find reachable sprites
     bool reachable[MAX_SPRITES] = { false };
 
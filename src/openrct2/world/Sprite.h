@@ -16,6 +16,9 @@
 #include "Fountain.h"
 #include "SpriteBase.h"
 
+#include <algorithm>
+#include <vector>
+
 #define SPRITE_INDEX_NULL 0xFFFF
 #define MAX_SPRITES 10000
 
@@ -216,6 +219,8 @@ template<typename T = SpriteBase> T* TryGetEntity(size_t sprite_idx)
 }
 
 uint16_t GetEntityListCount(EntityListId list);
+size_t EntityListPrefetchBegin(EntityListId list);
+void EntityListPrefetch(EntityListId list, size_t& cursor, uint16_t entityId);
 extern uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 extern uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
 
@@ -266,6 +271,22 @@ void crash_splash_create(const CoordsXYZ& splashPos);
 
 rct_sprite_checksum sprite_checksum();
 
+// Number of consecutive entity slots combined into one group hash of the sprite checksum tree.
+constexpr size_t SPRITE_CHECKSUM_GROUP_SIZE = 64;
+constexpr size_t SPRITE_CHECKSUM_GROUP_COUNT = (MAX_SPRITES + SPRITE_CHECKSUM_GROUP_SIZE - 1) / SPRITE_CHECKSUM_GROUP_SIZE;
+
+/**
+ * Checksum used for multiplayer desync detection. Each entity slot is reduced to a 64-bit hash, consecutive slots are
+ * combined into group hashes and the root is a SHA1 of all group hashes. Every leaf is recomputed on each call, but only
+ * groups with a changed leaf are combined again. Not compatible with sprite_checksum which replays still use.
+ */
+rct_sprite_checksum sprite_checksum_root();
+
+/**
+ * Group hashes from the last call to sprite_checksum_root, used to narrow down which entities diverged.
+ */
+const std::array<uint64_t, SPRITE_CHECKSUM_GROUP_COUNT>& sprite_checksum_groups();
+
 void sprite_set_flashing(SpriteBase* sprite, bool flashing);
 bool sprite_get_flashing(SpriteBase* sprite);
 int32_t check_for_sprite_list_cycles(bool fix);
@@ -276,6 +297,9 @@ template<typename T, uint16_t SpriteBase::*NextList> class EntityIterator
 private:
     T* Entity = nullptr;
     uint16_t NextEntityId = SPRITE_INDEX_NULL;
+    // Only set when walking an entity list, the entities visited next are then prefetched.
+    EntityListId PrefetchList = EntityListId::Count;
+    size_t PrefetchCursor = 0;
 
 public:
     EntityIterator(const uint16_t _EntityId)
@@ -283,12 +307,23 @@ public:
     {
         ++(*this);
     }
+    EntityIterator(EntityListId list, const uint16_t _EntityId)
+        : NextEntityId(_EntityId)
+        , PrefetchList(list)
+        , PrefetchCursor(EntityListPrefetchBegin(list))
+    {
+        ++(*this);
+    }
     EntityIterator& operator++()
     {
         Entity = nullptr;
 
         while (NextEntityId != SPRITE_INDEX_NULL && Entity == nullptr)
         {
+            if (PrefetchList != EntityListId::Count)
+            {
+                EntityListPrefetch(PrefetchList, PrefetchCursor, NextEntityId);
+            }
             auto baseEntity = GetEntity(NextEntityId);
             if (!baseEntity)
             {
@@ -352,18 +387,20 @@ public:
 template<typename T = SpriteBase> class EntityList
 {
 private:
+    EntityListId ListId = EntityListId::Free;
     uint16_t FirstEntity = SPRITE_INDEX_NULL;
     using EntityListIterator = EntityIterator<T, &SpriteBase::next>;
 
 public:
     EntityList(EntityListId type)
-        : FirstEntity(gSpriteListHead[static_cast<uint8_t>(type)])
+        : ListId(type)
+        , FirstEntity(gSpriteListHead[static_cast<uint8_t>(type)])
     {
     }
 
     EntityListIterator begin()
     {
-        return EntityListIterator(FirstEntity);
+        return EntityListIterator(ListId, FirstEntity);
     }
     EntityListIterator end()
     {
@@ -371,4 +408,104 @@ public:
     }
 };
 
+/**
+ * Reorders entityIds, which must all be in list, to the order in which walking list visits them.
+ */
+void EntityListSortByOrder(EntityListId list, std::vector<uint16_t>& entityIds);
+
+/**
+ * Finds up to count entities of type T from list satisfying pred that are nearest to loc, visiting the tiles of the
+ * spatial index in rings of growing distance around loc. distance(entity) must never be less than the Manhattan
+ * distance from loc to the entity, which lets the search stop once no unvisited tile can hold a nearer entity.
+ * Entities further than maxDistance or outside the map are ignored. The result is ordered by distance, entities at the
+ * same distance are ordered as walking list visits them, so the first result is the one a walk of list keeping the first
+ * entity with the lowest distance would find.
+ */
+template<typename T, typename TDistance, typename TPred>
+std::vector<T*> GetNearestEntities(
+    EntityListId list, const CoordsXY& loc, size_t count, uint32_t maxDistance, TDistance distance, TPred pred)
+{
+    std::vector<std::pair<uint32_t, T*>> nearest;
+    if (count == 0)
+        return {};
+
+    // Only the tiles of the current map can hold entities, searching up to the technical maximum would visit tens of
+    // thousands of empty tiles whenever nothing matches.
+    const int32_t mapSize = gMapSize;
+    auto centre = TileCoordsXY(loc);
+    auto lastRing = std::max({ centre.x, centre.y, mapSize - 1 - centre.x, mapSize - 1 - centre.y });
+    for (int32_t ring = 0; ring <= lastRing; ring++)
+    {
+        // Entities on the tiles of this ring are at least this far away along one of the axes.
+        uint32_t ringDistance = ring == 0 ? 0 : (ring - 1) * COORDS_XY_STEP + 1;
+        if (ringDistance > maxDistance)
+            break;
+        if (nearest.size() >= count && nearest[count - 1].first < ringDistance)
+            break;
+
+        auto visitTile = [&](int32_t tileX, int32_t tileY) {
+            if (tileX < 0 || tileY < 0 || tileX >= mapSize || tileY >= mapSize)
+                return;
+
+            for (auto* entity : EntityTileList<T>(TileCoordsXY{ tileX, tileY }.ToCoordsXY()))
+            {
+                if (!pred(*entity))
+                    continue;
+
+                uint32_t entityDistance = distance(*entity);
+                if (entityDistance > maxDistance)
+                    continue;
+
+                auto it = std::upper_bound(
+                    nearest.begin(), nearest.end(), entityDistance,
+                    [](uint32_t value, const std::pair<uint32_t, T*>& item) { return value < item.first; });
+                nearest.insert(it, { entityDistance, entity });
+            }
+        };
+
+        if (ring == 0)
+        {
+            visitTile(centre.x, centre.y);
+            continue;
+        }
+        for (int32_t i = -ring; i < ring; i++)
+        {
+            visitTile(centre.x + i, centre.y - ring);
+            visitTile(centre.x + ring, centre.y + i);
+            visitTile(centre.x - i, centre.y + ring);
+            visitTile(centre.x - ring, centre.y - i);
+        }
+    }
+
+    // Entities at the same distance were found in tile order, put the ones that can end up in the result in list order.
+    std::vector<T*> result;
+    for (size_t first = 0; first < nearest.size() && first < count;)
+    {
+        auto last = first + 1;
+        while (last < nearest.size() && nearest[last].first == nearest[first].first)
+        {
+            last++;
+        }
+        if (last - first > 1)
+        {
+            std::vector<uint16_t> entityIds;
+            for (auto i = first; i < last; i++)
+            {
+                entityIds.push_back(nearest[i].second->sprite_index);
+            }
+            EntityListSortByOrder(list, entityIds);
+            for (auto i = first; i < last; i++)
+            {
+                nearest[i].second = GetEntity<T>(entityIds[i - first]);
+            }
+        }
+        for (auto i = first; i < last && result.size() < count; i++)
+        {
+            result.push_back(nearest[i].second);
+        }
+        first = last;
+    }
+    return result;
+}
+
 #endif
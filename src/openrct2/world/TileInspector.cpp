@@ -17,10 +17,12 @@
 #include "../interface/Window.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Localisation.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
 #include "../windows/tile_inspector.h"
+#include "AmenityMap.h"
 #include "Banner.h"
 #include "Footpath.h"
 #include "LargeScenery.h"
@@ -219,6 +221,7 @@ GameActionResult::Ptr tile_inspector_remove_element_at(const CoordsXY& loc, int1
 
         tile_element_remove(tileElement);
         map_invalidate_tile_full(loc);
+        amenity_map_invalidate_tile(loc);
 
         // Update the window
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -251,6 +254,7 @@ GameActionResult::Ptr tile_inspector_swap_elements_at(const CoordsXY& loc, int16
             return std::make_unique<GameActionResult>(GA_ERROR::UNKNOWN, STR_NONE);
         }
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         // Update the window
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -340,6 +344,7 @@ GameActionResult::Ptr tile_inspector_rotate_element_at(const CoordsXY& loc, int3
         }
 
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         if (loc == windowTileInspectorTile.ToCoordsXY())
         {
@@ -454,6 +459,7 @@ GameActionResult::Ptr tile_inspector_sort_elements_at(const CoordsXY& loc, bool
         }
 
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         // Deselect tile for clients who had it selected
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -531,6 +537,7 @@ GameActionResult::Ptr tile_inspector_any_base_height_offset(
         tileElement->clearance_height += heightOffset;
 
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && loc == windowTileInspectorTile.ToCoordsXY())
@@ -684,6 +691,7 @@ GameActionResult::Ptr tile_inspector_path_set_sloped(const CoordsXY& loc, int32_
         pathElement->AsPath()->SetSloped(sloped);
 
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && loc == windowTileInspectorTile.ToCoordsXY())
@@ -707,6 +715,7 @@ GameActionResult::Ptr tile_inspector_path_set_broken(const CoordsXY& loc, int32_
         pathElement->AsPath()->SetIsBroken(broken);
 
         map_invalidate_tile_full(loc);
+        amenity_map_invalidate_tile(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && loc == windowTileInspectorTile.ToCoordsXY())
@@ -732,6 +741,7 @@ GameActionResult::Ptr tile_inspector_path_toggle_edge(
         pathElement->AsPath()->SetEdgesAndCorners(newEdges);
 
         map_invalidate_tile_full(loc);
+        footpath_graph_invalidate_tile(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && loc == windowTileInspectorTile.ToCoordsXY())
@@ -882,6 +892,7 @@ GameActionResult::Ptr tile_inspector_track_base_height_offset(
             elemZ += trackBlock->z;
 
             map_invalidate_tile_full(elem);
+            footpath_graph_invalidate_tile(elem);
 
             bool found = false;
             TileElement* tileElement = map_get_first_element_at({ elem.x, elem.y });
@@ -1153,6 +1164,7 @@ GameActionResult::Ptr tile_inspector_banner_toggle_blocking_edge(
         uint8_t edges = bannerElement->AsBanner()->GetAllowedEdges();
         edges ^= (1 << edgeIndex);
         bannerElement->AsBanner()->SetAllowedEdges(edges);
+        footpath_graph_invalidate();
 
         if (loc == windowTileInspectorTile.ToCoordsXY())
         {
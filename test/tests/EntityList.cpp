@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/world/Sprite.h>
+#include <vector>
+
+// Entity lists are iterated through EntityList, which prefetches using a dense copy of each list. Whatever happens to
+// the lists, the iteration order must stay that of the linked list.
+class EntityListTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        reset_sprite_list();
+    }
+
+    void TearDown() override
+    {
+        reset_sprite_list();
+    }
+
+    static std::vector<uint16_t> WalkLinkedList(EntityListId list)
+    {
+        std::vector<uint16_t> result;
+        for (uint16_t spriteIndex = gSpriteListHead[static_cast<uint8_t>(list)]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            result.push_back(spriteIndex);
+            spriteIndex = GetEntity(spriteIndex)->next;
+        }
+        return result;
+    }
+
+    static std::vector<uint16_t> Iterate(EntityListId list)
+    {
+        std::vector<uint16_t> result;
+        for (auto* entity : EntityList(list))
+        {
+            result.push_back(entity->sprite_index);
+        }
+        return result;
+    }
+
+    static std::vector<uint16_t> CreateVehicles(size_t count)
+    {
+        std::vector<uint16_t> result;
+        for (size_t i = 0; i < count; i++)
+        {
+            auto* entity = create_sprite(SPRITE_IDENTIFIER_VEHICLE);
+            EXPECT_NE(entity, nullptr);
+            if (entity != nullptr)
+            {
+                result.push_back(entity->generic.sprite_index);
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(EntityListTest, IteratesInLinkedListOrder)
+{
+    CreateVehicles(1000);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle).size(), 1000U);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+    ASSERT_EQ(Iterate(EntityListId::Free), WalkLinkedList(EntityListId::Free));
+}
+
+TEST_F(EntityListTest, RemovalsAndReinsertionsKeepOrder)
+{
+    auto vehicles = CreateVehicles(3000);
+    Iterate(EntityListId::Vehicle);
+
+    // Leave holes all over the list, then remove enough for the dense copy to be compacted.
+    for (size_t i = 0; i < vehicles.size(); i += 3)
+    {
+        sprite_remove(GetEntity(vehicles[i]));
+    }
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+    ASSERT_EQ(Iterate(EntityListId::Free), WalkLinkedList(EntityListId::Free));
+
+    for (size_t i = 1; i < vehicles.size(); i += 3)
+    {
+        sprite_remove(GetEntity(vehicles[i]));
+    }
+    ASSERT_EQ(GetEntityListCount(EntityListId::Vehicle), 1000U);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+
+    // Slots freed above are reused and end up at the head of the vehicle list.
+    CreateVehicles(500);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+    ASSERT_EQ(Iterate(EntityListId::Free), WalkLinkedList(EntityListId::Free));
+}
+
+TEST_F(EntityListTest, RemoveCurrentWhileIterating)
+{
+    CreateVehicles(200);
+    auto expected = WalkLinkedList(EntityListId::Vehicle);
+
+    std::vector<uint16_t> visited;
+    for (auto* entity : EntityList(EntityListId::Vehicle))
+    {
+        visited.push_back(entity->sprite_index);
+        if (entity->sprite_index % 2 == 0)
+        {
+            sprite_remove(entity);
+        }
+    }
+    ASSERT_EQ(visited, expected);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+}
+
+TEST_F(EntityListTest, CreateWhileIterating)
+{
+    CreateVehicles(100);
+    auto expected = WalkLinkedList(EntityListId::Vehicle);
+
+    // New entities become the head of the list, so an iteration already under way does not visit them.
+    std::vector<uint16_t> visited;
+    for (auto* entity : EntityList(EntityListId::Vehicle))
+    {
+        visited.push_back(entity->sprite_index);
+        CreateVehicles(1);
+    }
+    ASSERT_EQ(visited, expected);
+    ASSERT_EQ(GetEntityListCount(EntityListId::Vehicle), 200U);
+    ASSERT_EQ(Iterate(EntityListId::Vehicle), WalkLinkedList(EntityListId::Vehicle));
+}
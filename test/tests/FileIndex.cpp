@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileIndex.hpp>
+#include <openrct2/core/FileSystem.hpp>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Indexes text files, the item is the content of the file.
+class TestFileIndex final : public FileIndex<std::string>
+{
+public:
+    mutable std::atomic<size_t> Created = { 0 };
+
+    TestFileIndex(const std::string& indexPath, const std::string& directory)
+        : FileIndex("test index", 0x54534554, 1, indexPath, "*.txt", { directory })
+    {
+    }
+
+protected:
+    std::tuple<bool, std::string> Create([[maybe_unused]] int32_t language, const std::string& path) const override
+    {
+        Created++;
+        auto text = File::ReadAllText(path);
+        return std::make_tuple(text != "invalid", text);
+    }
+
+    void Serialise(IStream* stream, const std::string& item) const override
+    {
+        stream->WriteString(item);
+    }
+
+    std::string Deserialise(IStream* stream) const override
+    {
+        return stream->ReadStdString();
+    }
+};
+
+class FileIndexTest : public testing::Test
+{
+protected:
+    fs::path _directory;
+    std::string _indexPath;
+
+    void SetUp() override
+    {
+        _directory = fs::temp_directory_path() / "openrct2_fileindex_test";
+        fs::remove_all(_directory);
+        fs::create_directories(_directory / "files");
+        _indexPath = (_directory / "test.idx").string();
+
+        WriteFile("a.txt", "alpha");
+        WriteFile("b.txt", "bravo");
+        WriteFile("c.txt", "invalid");
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_directory);
+    }
+
+    void WriteFile(const std::string& name, const std::string& text)
+    {
+        File::WriteAllBytes((_directory / "files" / name).string(), text.data(), text.size());
+    }
+
+    std::vector<std::string> Load(size_t expectedCreated)
+    {
+        TestFileIndex index(_indexPath, (_directory / "files").string());
+        auto items = index.LoadOrBuild(0);
+        EXPECT_EQ(index.Created, expectedCreated);
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+};
+
+TEST_F(FileIndexTest, UnchangedFilesAreNotParsedAgain)
+{
+    std::vector<std::string> expected = { "alpha", "bravo" };
+    ASSERT_EQ(Load(3), expected);
+    ASSERT_EQ(Load(0), expected);
+}
+
+TEST_F(FileIndexTest, ModifiedFileIsParsedAgain)
+{
+    Load(3);
+    WriteFile("b.txt", "bravo two");
+    std::vector<std::string> expected = { "alpha", "bravo two" };
+    ASSERT_EQ(Load(1), expected);
+    ASSERT_EQ(Load(0), expected);
+}
+
+TEST_F(FileIndexTest, TouchedFileKeepsItsItem)
+{
+    Load(3);
+    auto path = _directory / "files" / "a.txt";
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::hours(1));
+    std::vector<std::string> expected = { "alpha", "bravo" };
+    ASSERT_EQ(Load(0), expected);
+}
+
+TEST_F(FileIndexTest, AddedAndRemovedFiles)
+{
+    Load(3);
+    fs::remove(_directory / "files" / "a.txt");
+    WriteFile("d.txt", "delta");
+    std::vector<std::string> expected = { "bravo", "delta" };
+    ASSERT_EQ(Load(1), expected);
+    ASSERT_EQ(Load(0), expected);
+}
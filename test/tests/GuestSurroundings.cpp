@@ -0,0 +1,478 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <bitset>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/object/ObjectRepository.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/world/AmenityMap.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/RidePresence.h>
+#include <openrct2/world/Scenery.h>
+#include <openrct2/world/Sprite.h>
+#include <optional>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Guests look for rides and assess their surroundings through indexes kept alongside the map. These must give exactly
+// what walking the tile elements around the guest used to give, for every position on the map.
+class GuestSurroundingsTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("pathfinding-tests.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        _context = nullptr;
+    }
+
+    static TileElement* InsertElement(const TileCoordsXY& loc, uint8_t type)
+    {
+        auto tileElement = tile_element_insert({ loc.ToCoordsXY(), 250 * COORDS_Z_STEP }, 0b1111);
+        EXPECT_NE(tileElement, nullptr);
+        if (tileElement != nullptr)
+        {
+            tileElement->SetType(type);
+        }
+        return tileElement;
+    }
+
+    static TileElement* InsertTrack(const TileCoordsXY& loc, ride_id_t rideIndex)
+    {
+        auto tileElement = InsertElement(loc, TILE_ELEMENT_TYPE_TRACK);
+        if (tileElement != nullptr)
+        {
+            tileElement->AsTrack()->SetRideIndex(rideIndex);
+        }
+        return tileElement;
+    }
+
+    static std::vector<ride_id_t> GetRideIds()
+    {
+        std::vector<ride_id_t> result;
+        for (const auto& ride : GetRideManager())
+        {
+            result.push_back(ride.id);
+        }
+        return result;
+    }
+
+    static void AddTrackRides(const TileCoordsXY& loc, std::bitset<MAX_RIDES>& rides)
+    {
+        auto tileElement = map_get_first_element_at(loc.ToCoordsXY());
+        if (tileElement == nullptr)
+            return;
+
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+            {
+                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                if (rideIndex < MAX_RIDES)
+                {
+                    rides[rideIndex] = true;
+                }
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    // The walk Guest::FindRidesToGoOn and peep_head_for_nearest_ride did before ride_presence_get_rides_near.
+    static std::bitset<MAX_RIDES> FindRidesNearByWalking(const CoordsXY& loc, int32_t radius)
+    {
+        std::bitset<MAX_RIDES> rides;
+        int32_t cx = floor2(loc.x, 32);
+        int32_t cy = floor2(loc.y, 32);
+        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
+        {
+            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
+            {
+                if (map_is_location_valid({ tileX, tileY }))
+                {
+                    AddTrackRides(TileCoordsXY(CoordsXY{ tileX, tileY }), rides);
+                }
+            }
+        }
+        return rides;
+    }
+
+    // The walk peep_assess_surroundings did before ride_presence_get_rides_in_range, centre is aligned to the tile grid.
+    static std::bitset<MAX_RIDES> FindRidesInRangeByWalking(int16_t centre_x, int16_t centre_y)
+    {
+        std::bitset<MAX_RIDES> rides;
+        int16_t initial_x = std::max(centre_x - 160, 0);
+        int16_t initial_y = std::max(centre_y - 160, 0);
+        int16_t final_x = std::min(centre_x + 160, MAXIMUM_MAP_SIZE_BIG);
+        int16_t final_y = std::min(centre_y + 160, MAXIMUM_MAP_SIZE_BIG);
+        for (int16_t x = initial_x; x < final_x; x += COORDS_XY_STEP)
+        {
+            for (int16_t y = initial_y; y < final_y; y += COORDS_XY_STEP)
+            {
+                AddTrackRides(TileCoordsXY(CoordsXY{ x, y }), rides);
+            }
+        }
+        return rides;
+    }
+
+    static void ExpectRidePresenceMatchesWalking()
+    {
+        constexpr int32_t radius = 10 * 32;
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                auto centre = TileCoordsXY{ x, y }.ToCoordsXY();
+                // Guests are rarely on the first coordinate of a tile, the search is around the tile they are on.
+                auto loc = centre + CoordsXY{ (x * 7) % COORDS_XY_STEP, (y * 13) % COORDS_XY_STEP };
+                ASSERT_EQ(ride_presence_get_rides_near(loc, radius), FindRidesNearByWalking(loc, radius))
+                    << "near " << x << ", " << y;
+
+                auto range = MapRange{ centre.x - 160, centre.y - 160, centre.x + 160 - COORDS_XY_STEP,
+                                       centre.y + 160 - COORDS_XY_STEP };
+                ASSERT_EQ(ride_presence_get_rides_in_range(range), FindRidesInRangeByWalking(centre.x, centre.y))
+                    << "in range of " << x << ", " << y;
+            }
+        }
+    }
+
+    static bool IsFountain(const rct_scenery_entry* entry)
+    {
+        return (entry->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW)) != 0;
+    }
+
+    // Finds a loaded path addition that is or is not a jumping fountain, loading the given object if there is none.
+    static std::optional<ObjectEntryIndex> FindPathAddition(bool fountain, const char* fallbackObject)
+    {
+        for (int32_t attempt = 0; attempt < 2; attempt++)
+        {
+            for (ObjectEntryIndex i = 0; i < MAX_PATH_ADDITION_OBJECTS; i++)
+            {
+                auto entry = get_footpath_item_entry(i);
+                if (entry != nullptr && IsFountain(entry) == fountain)
+                {
+                    return i;
+                }
+            }
+
+            auto item = object_repository_find_object_by_name(fallbackObject);
+            if (item == nullptr)
+                break;
+            object_manager_load_object(&item->ObjectEntry);
+        }
+        return std::nullopt;
+    }
+
+    static std::optional<ObjectEntryIndex> FindUnloadedPathAddition()
+    {
+        for (ObjectEntryIndex i = 0; i < MAX_PATH_ADDITION_OBJECTS; i++)
+        {
+            if (get_footpath_item_entry(i) == nullptr)
+            {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    static std::vector<TileCoordsXY> FindPathTiles()
+    {
+        std::vector<TileCoordsXY> result;
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                if (GetPath({ x, y }) != nullptr)
+                {
+                    result.push_back({ x, y });
+                }
+            }
+        }
+        return result;
+    }
+
+    static PathElement* GetPath(const TileCoordsXY& loc)
+    {
+        auto tileElement = map_get_first_element_at(loc.ToCoordsXY());
+        if (tileElement == nullptr)
+            return nullptr;
+
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+            {
+                return tileElement->AsPath();
+            }
+        } while (!(tileElement++)->IsLastForTile());
+        return nullptr;
+    }
+
+    static void SetPathAddition(const TileCoordsXY& loc, std::optional<ObjectEntryIndex> addition, bool broken, bool ghost)
+    {
+        auto pathElement = GetPath(loc);
+        ASSERT_NE(pathElement, nullptr);
+        pathElement->SetAddition(addition.has_value() ? *addition + 1 : 0);
+        pathElement->SetIsBroken(broken);
+        pathElement->SetAdditionIsGhost(ghost);
+        amenity_map_invalidate_tile(loc.ToCoordsXY());
+    }
+
+    static Litter* CreateLitter(const CoordsXY& loc)
+    {
+        auto litter = reinterpret_cast<Litter*>(create_sprite(SPRITE_IDENTIFIER_LITTER));
+        EXPECT_NE(litter, nullptr);
+        if (litter != nullptr)
+        {
+            litter->sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+            litter->type = LITTER_TYPE_RUBBISH;
+            litter->MoveTo({ loc, 14 * COORDS_Z_STEP });
+        }
+        return litter;
+    }
+
+    // The counting peep_assess_surroundings did before amenity_map_get_near, centre is aligned to the tile grid. It
+    // stopped at the first path addition whose object is not loaded, which is reported instead of the counts.
+    static AmenityCounts CountAmenitiesByWalking(int16_t centre_x, int16_t centre_y)
+    {
+        AmenityCounts result{};
+        int16_t initial_x = std::max(centre_x - 160, 0);
+        int16_t initial_y = std::max(centre_y - 160, 0);
+        int16_t final_x = std::min(centre_x + 160, MAXIMUM_MAP_SIZE_BIG);
+        int16_t final_y = std::min(centre_y + 160, MAXIMUM_MAP_SIZE_BIG);
+        for (int16_t x = initial_x; x < final_x; x += COORDS_XY_STEP)
+        {
+            for (int16_t y = initial_y; y < final_y; y += COORDS_XY_STEP)
+            {
+                auto tileElement = map_get_first_element_at({ x, y });
+                if (tileElement == nullptr)
+                    continue;
+                do
+                {
+                    switch (tileElement->GetType())
+                    {
+                        case TILE_ELEMENT_TYPE_PATH:
+                        {
+                            if (!tileElement->AsPath()->HasAddition())
+                                break;
+
+                            auto scenery = tileElement->AsPath()->GetAdditionEntry();
+                            if (scenery == nullptr)
+                            {
+                                result.HasMissingPathAdditions = true;
+                                return result;
+                            }
+                            if (tileElement->AsPath()->AdditionIsGhost())
+                                break;
+
+                            if (IsFountain(scenery))
+                            {
+                                result.Fountains++;
+                                break;
+                            }
+                            if (tileElement->AsPath()->IsBroken())
+                            {
+                                result.Rubbish++;
+                            }
+                            break;
+                        }
+                        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                            result.Scenery++;
+                            break;
+                    }
+                } while (!(tileElement++)->IsLastForTile());
+            }
+        }
+
+        for (auto litter : EntityList<Litter>(EntityListId::Litter))
+        {
+            int16_t dist_x = abs(litter->x - centre_x);
+            int16_t dist_y = abs(litter->y - centre_y);
+            if (std::max(dist_x, dist_y) <= 160)
+            {
+                result.Rubbish++;
+            }
+        }
+        return result;
+    }
+
+    static void ExpectAmenitiesMatchWalking()
+    {
+        for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                auto centre = TileCoordsXY{ x, y }.ToCoordsXY();
+                auto expected = CountAmenitiesByWalking(centre.x, centre.y);
+                auto actual = amenity_map_get_near(centre, 160);
+                ASSERT_EQ(actual.HasMissingPathAdditions, expected.HasMissingPathAdditions) << "at " << x << ", " << y;
+                if (!expected.HasMissingPathAdditions)
+                {
+                    ASSERT_EQ(actual.Scenery, expected.Scenery) << "at " << x << ", " << y;
+                    ASSERT_EQ(actual.Fountains, expected.Fountains) << "at " << x << ", " << y;
+                    ASSERT_EQ(actual.Rubbish, expected.Rubbish) << "at " << x << ", " << y;
+                }
+            }
+        }
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> GuestSurroundingsTest::_context;
+
+TEST_F(GuestSurroundingsTest, RidePresenceMatchesWalkingTheMap)
+{
+    auto rideIds = GetRideIds();
+    ASSERT_GE(rideIds.size(), 2U);
+    ExpectRidePresenceMatchesWalking();
+
+    // Track either side of the block boundaries and in the corners of the map, where the searches are clipped.
+    const TileCoordsXY trackTiles[] = {
+        { 0, 0 },   { 7, 7 },   { 8, 8 },   { 15, 16 }, { 16, 15 },   { 255, 255 },
+        { 255, 0 }, { 0, 255 }, { 39, 40 }, { 40, 39 }, { 247, 248 }, { 248, 247 },
+    };
+    for (size_t i = 0; i < std::size(trackTiles); i++)
+    {
+        InsertTrack(trackTiles[i], rideIds[i % rideIds.size()]);
+    }
+    ExpectRidePresenceMatchesWalking();
+
+    // Removing track only invalidates the blocks the ride has track in.
+    for (size_t i = 0; i < std::size(trackTiles); i += 2)
+    {
+        auto tileElement = map_get_first_element_at(trackTiles[i].ToCoordsXY());
+        ASSERT_NE(tileElement, nullptr);
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK && tileElement->GetBaseZ() == 250 * COORDS_Z_STEP)
+            {
+                tile_element_remove(tileElement);
+                break;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    ExpectRidePresenceMatchesWalking();
+}
+
+TEST_F(GuestSurroundingsTest, AmenitiesMatchWalkingTheMap)
+{
+    auto fountain = FindPathAddition(true, "JUMPFNT1");
+    auto bench = FindPathAddition(false, "BENCH1");
+    ASSERT_TRUE(fountain.has_value());
+    ASSERT_TRUE(bench.has_value());
+
+    // Every kind of path addition, broken or not and ghosts, spread over the paths of the park.
+    auto pathTiles = FindPathTiles();
+    ASSERT_FALSE(pathTiles.empty());
+    for (size_t i = 0; i < pathTiles.size(); i++)
+    {
+        switch (i % 6)
+        {
+            case 0:
+                SetPathAddition(pathTiles[i], fountain, false, false);
+                break;
+            case 1:
+                SetPathAddition(pathTiles[i], bench, true, false);
+                break;
+            case 2:
+                SetPathAddition(pathTiles[i], bench, false, false);
+                break;
+            case 3:
+                SetPathAddition(pathTiles[i], bench, true, true);
+                break;
+            case 4:
+                SetPathAddition(pathTiles[i], fountain, true, true);
+                break;
+        }
+    }
+
+    // Scenery either side of the edges of a guest's surroundings and in the corners of the map.
+    const TileCoordsXY sceneryTiles[] = {
+        { 0, 0 },   { 1, 0 },   { 255, 255 }, { 254, 255 }, { 0, 255 }, { 255, 0 },
+        { 20, 20 }, { 20, 21 }, { 25, 20 },   { 14, 20 },   { 15, 20 }, { 20, 25 },
+    };
+    for (size_t i = 0; i < std::size(sceneryTiles); i++)
+    {
+        InsertElement(sceneryTiles[i], i % 2 == 0 ? TILE_ELEMENT_TYPE_SMALL_SCENERY : TILE_ELEMENT_TYPE_LARGE_SCENERY);
+    }
+
+    // Litter is counted up to 160 units away inclusive, so litter on the first coordinate of a tile along either axis
+    // is within reach of guests one tile further away than the rest of that tile.
+    const CoordsXY litterOffsets[] = { { 0, 0 }, { 0, 17 }, { 9, 0 }, { 31, 31 }, { 1, 1 } };
+    const TileCoordsXY litterTiles[] = { { 0, 0 }, { 10, 10 }, { 12, 17 }, { 17, 12 }, { 255, 255 }, { 30, 3 } };
+    std::vector<Litter*> litter;
+    for (const auto& tile : litterTiles)
+    {
+        for (const auto& offset : litterOffsets)
+        {
+            litter.push_back(CreateLitter(tile.ToCoordsXY() + offset));
+        }
+    }
+    ExpectAmenitiesMatchWalking();
+
+    // Counts must follow litter that moves or is picked up, and path additions that break or are removed.
+    for (size_t i = 0; i < litter.size(); i++)
+    {
+        if (litter[i] == nullptr)
+            continue;
+
+        if (i % 3 == 0)
+        {
+            // Onto the neighbouring tile, changing whether it is on the first coordinate of a tile along x.
+            CoordsXYZ loc = { litter[i]->x, litter[i]->y, litter[i]->z };
+            loc.x += (loc.x % COORDS_XY_STEP) == 0 ? 1 : -1;
+            loc.y += loc.y < MAXIMUM_MAP_SIZE_BIG / 2 ? COORDS_XY_STEP : -COORDS_XY_STEP;
+            litter[i]->MoveTo(loc);
+        }
+        else if (i % 3 == 1)
+        {
+            sprite_remove(litter[i]);
+        }
+    }
+    for (size_t i = 0; i < pathTiles.size(); i += 4)
+    {
+        SetPathAddition(pathTiles[i], bench, i % 8 == 0, false);
+    }
+    for (size_t i = 1; i < pathTiles.size(); i += 7)
+    {
+        SetPathAddition(pathTiles[i], std::nullopt, false, false);
+    }
+    ExpectAmenitiesMatchWalking();
+
+    // A path addition whose object is not loaded makes guests skip the assessment of everything around it.
+    auto unloaded = FindUnloadedPathAddition();
+    if (unloaded.has_value())
+    {
+        SetPathAddition(pathTiles.front(), unloaded, false, false);
+        ExpectAmenitiesMatchWalking();
+        SetPathAddition(pathTiles.front(), std::nullopt, false, false);
+    }
+}
@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <array>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.hpp>
+#include <vector>
+
+// Enough items to force splitting across all workers.
+constexpr size_t TEST_ITEM_COUNT = 100000;
+
+TEST(JobPoolTest, AddTaskRunsEveryTask)
+{
+    JobPool pool;
+    std::atomic<size_t> executed = { 0 };
+    size_t completed = 0;
+    for (size_t i = 0; i < 5000; i++)
+    {
+        pool.AddTask([&executed]() { executed++; }, [&completed]() { completed++; });
+    }
+    pool.Join();
+
+    ASSERT_EQ(executed, 5000U);
+    ASSERT_EQ(completed, 5000U);
+    ASSERT_EQ(pool.CountPending(), 0U);
+}
+
+TEST(JobPoolTest, AddTaskWithLargeCapture)
+{
+    JobPool pool;
+    std::array<uint64_t, 32> values{};
+    values.fill(3);
+
+    std::atomic<uint64_t> sum = { 0 };
+    for (size_t i = 0; i < 100; i++)
+    {
+        pool.AddTask([values, &sum]() {
+            for (auto v : values)
+                sum += v;
+        });
+    }
+    pool.Join();
+
+    ASSERT_EQ(sum, 100U * 32U * 3U);
+}
+
+TEST(JobPoolTest, ParallelForVisitsEachIndexOnce)
+{
+    JobPool pool;
+    for (size_t grainSize : { size_t(1), size_t(7), size_t(100), TEST_ITEM_COUNT * 2 })
+    {
+        std::vector<uint8_t> visited(TEST_ITEM_COUNT, 0);
+        pool.ParallelFor(visited.size(), [&visited](size_t i) { visited[i]++; }, grainSize);
+
+        for (auto v : visited)
+        {
+            ASSERT_EQ(v, 1);
+        }
+    }
+}
+
+TEST(JobPoolTest, ParallelForRepeated)
+{
+    // Mirrors viewport painting which issues a small ParallelFor every frame.
+    JobPool pool;
+    for (size_t frame = 0; frame < 500; frame++)
+    {
+        std::vector<size_t> columns(frame % 130);
+        pool.ParallelFor(columns.size(), [&columns](size_t i) { columns[i] = i * 2; });
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            ASSERT_EQ(columns[i], i * 2);
+        }
+    }
+}
+
+TEST(JobPoolTest, SingleThread)
+{
+    JobPool pool(1);
+    ASSERT_EQ(pool.CountThreads(), 1U);
+
+    size_t sum = 0;
+    pool.ParallelFor(1000, [&sum](size_t i) { sum += i; });
+    ASSERT_EQ(sum, 999U * 1000U / 2U);
+}
+
+TEST(JobPoolTest, Stats)
+{
+    JobPool pool;
+    std::atomic<size_t> executed = { 0 };
+    pool.ParallelFor(TEST_ITEM_COUNT, [&executed](size_t) { executed++; });
+
+    auto stats = pool.GetStats();
+    ASSERT_EQ(executed, TEST_ITEM_COUNT);
+    ASSERT_GE(stats.TasksExecuted, 1U);
+    ASSERT_GE(stats.PeakQueueDepth, 1U);
+
+    pool.ResetStats();
+    stats = pool.GetStats();
+    ASSERT_EQ(stats.TasksExecuted, 0U);
+    ASSERT_EQ(stats.Steals, 0U);
+    ASSERT_EQ(stats.PeakQueueDepth, 0U);
+}
@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <utility>
+
+using namespace OpenRCT2;
+
+static MemoryStream CreateStream()
+{
+    MemoryStream ms;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        ms.WriteValue<uint32_t>(i);
+    }
+    return ms;
+}
+
+static void ExpectStreamContents(MemoryStream& ms)
+{
+    ASSERT_EQ(ms.GetLength(), 1000U * sizeof(uint32_t));
+    ms.SetPosition(0);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(ms.ReadValue<uint32_t>(), i);
+    }
+}
+
+TEST(MemoryStreamTest, MoveConstructKeepsContents)
+{
+    auto source = CreateStream();
+    auto position = source.GetPosition();
+
+    MemoryStream moved(std::move(source));
+    ASSERT_EQ(moved.GetPosition(), position);
+    ExpectStreamContents(moved);
+    ASSERT_EQ(source.GetLength(), 0U);
+}
+
+TEST(MemoryStreamTest, MoveAssignKeepsContents)
+{
+    auto source = CreateStream();
+
+    MemoryStream moved;
+    moved.WriteValue<uint64_t>(0);
+    moved = std::move(source);
+    ExpectStreamContents(moved);
+    ASSERT_EQ(source.GetLength(), 0U);
+}
+
+TEST(MemoryStreamTest, MovedIntoLambdaKeepsContents)
+{
+    // Streams are moved into jobs that run on another thread, see NetworkBase::save_for_network.
+    auto job = [ms = CreateStream()]() mutable { ExpectStreamContents(ms); };
+    auto movedJob = std::move(job);
+    movedJob();
+}
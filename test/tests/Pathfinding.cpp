@@ -1,15 +1,19 @@
 #include "TestData.h"
 #include "openrct2/core/StringReader.hpp"
+#include "openrct2/peep/FootpathGraph.h"
 #include "openrct2/peep/GuestPathfinding.h"
 #include "openrct2/peep/Peep.h"
 #include "openrct2/ride/Station.h"
 #include "openrct2/scenario/Scenario.h"
 
+#include <chrono>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
@@ -21,6 +25,25 @@ static std::ostream& operator<<(std::ostream& os, const TileCoordsXYZ& coords)
     return os << "(" << coords.x << ", " << coords.y << ", " << coords.z << ")";
 }
 
+struct SimplePathfindingScenario
+{
+    const char* name;
+    TileCoordsXYZ start;
+    uint32_t steps;
+
+    SimplePathfindingScenario(const char* _name, const TileCoordsXYZ& _start, int _steps)
+        : name(_name)
+        , start(_start)
+        , steps(_steps)
+    {
+    }
+
+    static std::string ToName(const ::testing::TestParamInfo<SimplePathfindingScenario>& param_info)
+    {
+        return param_info.param.name;
+    }
+};
+
 class PathfindingTestBase : public testing::Test
 {
 public:
@@ -43,6 +66,13 @@ public:
     {
         // Use a consistent random seed in every test
         scenario_rand_seed(0x12345678, 0x87654321);
+        _cachedPathfinding = gConfigGeneral.cached_pathfinding;
+    }
+
+    void TearDown() override
+    {
+        // Tests switch between the pathfinders, restore the setting even when one of them fails.
+        gConfigGeneral.cached_pathfinding = _cachedPathfinding;
     }
 
     static void TearDownTestCase()
@@ -64,7 +94,8 @@ protected:
         return nullptr;
     }
 
-    static bool FindPath(TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID)
+    static bool FindPath(
+        TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID, bool exactSteps = true)
     {
         // Our start position is in tile coordinates, but we need to give the peep spawn
         // position in actual world coords (32 units per tile X/Y, 8 per Z level).
@@ -127,7 +158,10 @@ protected:
         // such a change in the number of steps taken on one of these paths needs to be reviewed. For the negative
         // tests, we will not have reached the goal but we still expect the loop to have run for the total number
         // of steps requested before giving up.
-        EXPECT_EQ(step, expectedSteps);
+        if (exactSteps)
+        {
+            EXPECT_EQ(step, expectedSteps);
+        }
 
         return *pos == goal;
     }
@@ -160,56 +194,66 @@ protected:
         return ::testing::AssertionSuccess();
     }
 
-private:
-    static std::shared_ptr<IContext> _context;
-};
+    static void RunSimpleScenario(const SimplePathfindingScenario& scenario, bool exactSteps)
+    {
+        ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+        TileCoordsXYZ pos = scenario.start;
 
-std::shared_ptr<IContext> PathfindingTestBase::_context;
+        auto ride = FindRideByName(scenario.name);
+        ASSERT_NE(ride, nullptr);
 
-struct SimplePathfindingScenario
-{
-    const char* name;
-    TileCoordsXYZ start;
-    uint32_t steps;
+        auto entrancePos = ride_get_entrance_location(ride, 0);
+        TileCoordsXYZ goal = TileCoordsXYZ(
+            entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
 
-    SimplePathfindingScenario(const char* _name, const TileCoordsXYZ& _start, int _steps)
-        : name(_name)
-        , start(_start)
-        , steps(_steps)
-    {
+        const auto succeeded = FindPath(&pos, goal, scenario.steps, ride->id, exactSteps)
+            ? ::testing::AssertionSuccess()
+            : ::testing::AssertionFailure() << "Failed to find path from " << scenario.start << " to " << goal << " in "
+                                            << scenario.steps << " steps; reached " << pos << " before giving up.";
+
+        EXPECT_TRUE(succeeded);
     }
 
-    static std::string ToName(const ::testing::TestParamInfo<SimplePathfindingScenario>& param_info)
+    static void RunImpossibleScenario(const SimplePathfindingScenario& scenario)
     {
-        return param_info.param.name;
+        TileCoordsXYZ pos = scenario.start;
+        ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+
+        auto ride = FindRideByName(scenario.name);
+        ASSERT_NE(ride, nullptr);
+
+        auto entrancePos = ride_get_entrance_location(ride, 0);
+        TileCoordsXYZ goal = TileCoordsXYZ(
+            entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+        EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
     }
+
+private:
+    static std::shared_ptr<IContext> _context;
+    bool _cachedPathfinding = false;
 };
 
+std::shared_ptr<IContext> PathfindingTestBase::_context;
+
 class SimplePathfindingTest : public PathfindingTestBase, public ::testing::WithParamInterface<SimplePathfindingScenario>
 {
 };
 
 TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoal)
 {
-    const SimplePathfindingScenario& scenario = GetParam();
-
-    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
-    TileCoordsXYZ pos = scenario.start;
-
-    auto ride = FindRideByName(scenario.name);
-    ASSERT_NE(ride, nullptr);
-
-    auto entrancePos = ride_get_entrance_location(ride, 0);
-    TileCoordsXYZ goal = TileCoordsXYZ(
-        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
-        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
-
-    const auto succeeded = FindPath(&pos, goal, scenario.steps, ride->id) ? ::testing::AssertionSuccess()
-                                                                          : ::testing::AssertionFailure()
-            << "Failed to find path from " << scenario.start << " to " << goal << " in " << scenario.steps << " steps; reached "
-            << pos << " before giving up.";
+    gConfigGeneral.cached_pathfinding = false;
+    RunSimpleScenario(GetParam(), true);
+}
 
-    EXPECT_TRUE(succeeded);
+// The step counts are those of the heuristic search, the cached planner must reach the goal within them but is free to
+// take a different route.
+TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoalCached)
+{
+    gConfigGeneral.cached_pathfinding = true;
+    RunSimpleScenario(GetParam(), false);
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -230,19 +274,14 @@ class ImpossiblePathfindingTest : public PathfindingTestBase, public ::testing::
 
 TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoal)
 {
-    const SimplePathfindingScenario& scenario = GetParam();
-    TileCoordsXYZ pos = scenario.start;
-    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
-
-    auto ride = FindRideByName(scenario.name);
-    ASSERT_NE(ride, nullptr);
-
-    auto entrancePos = ride_get_entrance_location(ride, 0);
-    TileCoordsXYZ goal = TileCoordsXYZ(
-        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
-        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+    gConfigGeneral.cached_pathfinding = false;
+    RunImpossibleScenario(GetParam());
+}
 
-    EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
+TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoalCached)
+{
+    gConfigGeneral.cached_pathfinding = true;
+    RunImpossibleScenario(GetParam());
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -252,3 +291,59 @@ INSTANTIATE_TEST_CASE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+class PathfindingBenchmarkTest : public PathfindingTestBase
+{
+};
+
+TEST_F(PathfindingBenchmarkTest, ChooseDirectionHeuristicAndCached)
+{
+    static constexpr int32_t iterations = 1000;
+    const SimplePathfindingScenario scenarios[] = {
+        SimplePathfindingScenario("CBend", { 14, 5, 14 }, 164),
+        SimplePathfindingScenario("TwoUnequalRoutes", { 3, 13, 14 }, 87),
+        SimplePathfindingScenario("SelfCrossingPath", { 6, 5, 14 }, 213),
+    };
+
+    for (const auto& scenario : scenarios)
+    {
+        auto ride = FindRideByName(scenario.name);
+        ASSERT_NE(ride, nullptr);
+
+        auto entrancePos = ride_get_entrance_location(ride, 0);
+        TileCoordsXYZ goal = TileCoordsXYZ(
+            entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+        Peep* peep = Peep::Generate(scenario.start.ToCoordsXYZ().ToTileCentre());
+        peep->OutsideOfPark = false;
+        gPeepPathFindGoalPosition = goal;
+        gPeepPathFindQueueRideIndex = ride->id;
+        gPeepPathFindIgnoreForeignQueues = true;
+
+        // The cached planner must find the goal on its own rather than falling back to the heuristic search.
+        EXPECT_NE(footpath_graph_choose_direction(scenario.start, 0b1111, goal, ride->id, true), INVALID_DIRECTION);
+
+        std::chrono::steady_clock::duration times[2]{};
+        bool foundDirection = true;
+        for (int32_t mode = 0; mode < 2 && foundDirection; mode++)
+        {
+            gConfigGeneral.cached_pathfinding = mode != 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int32_t i = 0; i < iterations && foundDirection; i++)
+            {
+                // Start every search afresh, without the junctions remembered from the previous one.
+                peep->ResetPathfindGoal();
+                foundDirection = peep_pathfind_choose_direction(scenario.start, peep) != INVALID_DIRECTION;
+            }
+            times[mode] = std::chrono::steady_clock::now() - start;
+        }
+        peep_sprite_remove(peep);
+        EXPECT_TRUE(foundDirection) << scenario.name;
+
+        std::printf(
+            "%s: heuristic %.2f us, cached %.2f us per direction\n", scenario.name,
+            std::chrono::duration<double, std::micro>(times[0]).count() / iterations,
+            std::chrono::duration<double, std::micro>(times[1]).count() / iterations);
+    }
+}
@@ -9,6 +9,7 @@
 
 #include "TestData.h"
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
@@ -16,6 +17,7 @@
 #include <openrct2/ParkImporter.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -171,3 +173,153 @@ TEST_F(TileElementWantsFootpathConnection, MapEdge)
     // The tile in the -X direction is a normal tile and should not be marked as an edge
     EXPECT_FALSE(edges & (1 << 2));
 }
+
+class TileElementAllocation : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    void SetUp() override
+    {
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+
+        // Start with all elements packed at the front and no vacated runs
+        map_reorganise_elements();
+    }
+
+    static uint32_t CountElements(const TileCoordsXY& pos)
+    {
+        uint32_t count = 0;
+        const TileElement* tileElement = map_get_first_element_at(pos.ToCoordsXY());
+        if (tileElement != nullptr)
+        {
+            do
+            {
+                count++;
+            } while (!(tileElement++)->IsLastForTile());
+        }
+        return count;
+    }
+
+    static TileCoordsXY FindTile(uint32_t numElements, const std::vector<TileCoordsXY>& exclude = {})
+    {
+        for (int32_t y = 1; y < gMapSize - 1; y++)
+        {
+            for (int32_t x = 1; x < gMapSize - 1; x++)
+            {
+                TileCoordsXY pos{ x, y };
+                if (CountElements(pos) == numElements && std::find(exclude.begin(), exclude.end(), pos) == exclude.end())
+                {
+                    return pos;
+                }
+            }
+        }
+        ADD_FAILURE() << "No tile with " << numElements << " elements";
+        return {};
+    }
+
+    // Inserts an element above everything else on the tile
+    static TileElement* InsertElement(const TileCoordsXY& pos)
+    {
+        auto* tileElement = tile_element_insert({ pos.ToCoordsXY(), 250 * COORDS_Z_STEP }, 0b1111);
+        if (tileElement != nullptr)
+        {
+            tileElement->SetType(TILE_ELEMENT_TYPE_CORRUPT);
+        }
+        return tileElement;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> TileElementAllocation::_context;
+
+TEST_F(TileElementAllocation, InsertReusesVacatedRun)
+{
+    auto tileA = FindTile(2);
+    auto tileB = FindTile(1, { tileA });
+    TileElement* const vacatedRun = map_get_first_element_at(tileA.ToCoordsXY());
+    TileElement* const nextFree = gNextFreeTileElement;
+
+    // Tile A does not fit its old place anymore and moves to the end
+    ASSERT_NE(InsertElement(tileA), nullptr);
+    EXPECT_EQ(CountElements(tileA), 3U);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 3);
+    const auto numAtEnd = static_cast<uint32_t>(&gTileElements[MAX_TILE_ELEMENTS] - gNextFreeTileElement);
+    EXPECT_EQ(map_get_num_free_tile_elements(), numAtEnd + 2);
+
+    // Tile B now needs as many elements as tile A had, so it takes over its old place
+    ASSERT_NE(InsertElement(tileB), nullptr);
+    EXPECT_EQ(CountElements(tileB), 2U);
+    EXPECT_EQ(map_get_first_element_at(tileB.ToCoordsXY()), vacatedRun);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 3);
+}
+
+TEST_F(TileElementAllocation, FullEndUsesVacatedRunsBeforeDefragmenting)
+{
+    auto tileA = FindTile(2);
+    auto tileB = FindTile(1, { tileA });
+    ASSERT_NE(InsertElement(tileA), nullptr);
+
+    // Pretend the end of the element array has been used up
+    TileElement* const tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
+    gNextFreeTileElement = tileElementEnd;
+    ASSERT_EQ(map_get_num_free_tile_elements(), 2U);
+
+    // The run vacated by tile A has room, so there is no need to defragment
+    EXPECT_TRUE(map_check_free_elements_and_reorganise(2));
+    EXPECT_EQ(gNextFreeTileElement, tileElementEnd);
+    ASSERT_NE(InsertElement(tileB), nullptr);
+    EXPECT_EQ(gNextFreeTileElement, tileElementEnd);
+    EXPECT_EQ(map_get_num_free_tile_elements(), 0U);
+
+    // Once the vacated runs are used up as well, the element array gets defragmented
+    EXPECT_TRUE(map_check_free_elements_and_reorganise(1));
+    EXPECT_LT(gNextFreeTileElement, tileElementEnd);
+    EXPECT_EQ(CountElements(tileA), 3U);
+    EXPECT_EQ(CountElements(tileB), 2U);
+}
+
+TEST_F(TileElementAllocation, InsertDefragmentsWhenVacatedRunsAreTooShort)
+{
+    auto tileA = FindTile(2);
+    std::vector<TileCoordsXY> usedTiles{ tileA };
+    for (int32_t i = 0; i < 3; i++)
+    {
+        // Each of these leaves a run of a single element behind
+        auto tile = FindTile(1, usedTiles);
+        usedTiles.push_back(tile);
+        ASSERT_NE(InsertElement(tile), nullptr);
+    }
+
+    TileElement* const tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
+    gNextFreeTileElement = tileElementEnd;
+    ASSERT_EQ(map_get_num_free_tile_elements(), 3U);
+    EXPECT_TRUE(map_check_free_elements_and_reorganise(1));
+    EXPECT_EQ(gNextFreeTileElement, tileElementEnd);
+
+    // Tile A needs three consecutive elements, which only defragmenting can provide
+    ASSERT_NE(InsertElement(tileA), nullptr);
+    EXPECT_LT(gNextFreeTileElement, tileElementEnd);
+    EXPECT_EQ(CountElements(tileA), 3U);
+    for (size_t i = 1; i < usedTiles.size(); i++)
+    {
+        EXPECT_EQ(CountElements(usedTiles[i]), 2U);
+    }
+}
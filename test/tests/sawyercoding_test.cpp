@@ -7,13 +7,175 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "TestData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/FileStream.hpp>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
+// The scalar encoders as they were before the codec was optimised. Saved parks must stay byte-identical, so the current
+// encoder is checked against these.
+static size_t reference_encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const uint8_t* end_src = src + length;
+    uint8_t count = 0;
+    const uint8_t* src_norm_start = src;
+
+    while (src < end_src - 1)
+    {
+        if ((count && *src == src[1]) || count > 125)
+        {
+            *dst++ = count - 1;
+            std::memcpy(dst, src_norm_start, count);
+            dst += count;
+            src_norm_start += count;
+            count = 0;
+        }
+        if (*src == src[1])
+        {
+            for (; (count < 125) && ((src + count) < end_src); count++)
+            {
+                if (*src != src[count])
+                    break;
+            }
+            *dst++ = 257 - count;
+            *dst++ = *src;
+            src += count;
+            src_norm_start = src;
+            count = 0;
+        }
+        else
+        {
+            count++;
+            src++;
+        }
+    }
+    if (src == end_src - 1)
+        count++;
+    if (count)
+    {
+        *dst++ = count - 1;
+        std::memcpy(dst, src_norm_start, count);
+        dst += count;
+    }
+    return dst - dst_buffer;
+}
+
+static size_t reference_encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    if (length == 0)
+        return 0;
+
+    size_t outLength = 0;
+
+    // Need to emit at least one byte, otherwise there is nothing to repeat
+    *dst_buffer++ = 255;
+    *dst_buffer++ = src_buffer[0];
+    outLength += 2;
+
+    // Iterate through remainder of the source buffer
+    for (size_t i = 1; i < length;)
+    {
+        size_t searchIndex = (i < 32) ? 0 : (i - 32);
+        size_t searchEnd = i - 1;
+
+        size_t bestRepeatIndex = 0;
+        size_t bestRepeatCount = 0;
+        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
+        {
+            size_t repeatCount = 0;
+            size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
+            for (size_t j = 0; j <= maxRepeatCount; j++)
+            {
+                if (src_buffer[repeatIndex + j] == src_buffer[i + j])
+                {
+                    repeatCount++;
+                }
+                else
+                {
+                    break;
+                }
+            }
+            if (repeatCount > bestRepeatCount)
+            {
+                bestRepeatIndex = repeatIndex;
+                bestRepeatCount = repeatCount;
+
+                // Maximum repeat count is 8
+                if (repeatCount == 8)
+                    break;
+            }
+        }
+
+        if (bestRepeatCount == 0)
+        {
+            *dst_buffer++ = 255;
+            *dst_buffer++ = src_buffer[i];
+            outLength += 2;
+            i++;
+        }
+        else
+        {
+            *dst_buffer++ = static_cast<uint8_t>((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
+            outLength++;
+            i += bestRepeatCount;
+        }
+    }
+
+    return outLength;
+}
+
+static std::vector<uint8_t> reference_write_chunk(const uint8_t* buffer, sawyercoding_chunk_header chunkHeader)
+{
+    std::vector<uint8_t> encoded;
+    switch (chunkHeader.encoding)
+    {
+        case CHUNK_ENCODING_NONE:
+            encoded.assign(buffer, buffer + chunkHeader.length);
+            break;
+        case CHUNK_ENCODING_RLE:
+            encoded.resize(chunkHeader.length * 2 + 2);
+            encoded.resize(reference_encode_chunk_rle(buffer, encoded.data(), chunkHeader.length));
+            break;
+        case CHUNK_ENCODING_RLECOMPRESSED:
+        {
+            std::vector<uint8_t> repeated(chunkHeader.length * 2);
+            repeated.resize(reference_encode_chunk_repeat(buffer, repeated.data(), chunkHeader.length));
+            encoded.resize(repeated.size() * 2 + 2);
+            encoded.resize(reference_encode_chunk_rle(repeated.data(), encoded.data(), repeated.size()));
+            break;
+        }
+        case CHUNK_ENCODING_ROTATE:
+        {
+            encoded.assign(buffer, buffer + chunkHeader.length);
+            uint8_t code = 1;
+            for (auto& b : encoded)
+            {
+                b = rol8(b, code);
+                code = (code + 2) % 8;
+            }
+            break;
+        }
+    }
+
+    chunkHeader.length = static_cast<uint32_t>(encoded.size());
+    auto header = reinterpret_cast<const uint8_t*>(&chunkHeader);
+    encoded.insert(encoded.begin(), header, header + sizeof(chunkHeader));
+    return encoded;
+}
+
 class SawyerCodingTest : public testing::Test
 {
 protected:
@@ -106,6 +268,85 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+// Re-encodes every chunk of the test parks, checks that every encoding matches the reference encoder byte for byte and
+// that chunks decode back to the same data. The throughput of both directions is printed, so changes to the codec can
+// be measured on real park data.
+TEST_F(SawyerCodingTest, park_corpus_throughput)
+{
+    constexpr int32_t iterations = 5;
+    const char* parks[] = {
+        "bpb.sv6",
+        "pathfinding-tests.sv6",
+        "small_park_car_ride_one_car.sv6",
+        "small_park_with_ferris_wheel.sv6",
+        "tile-element-tests.sv6",
+    };
+
+    std::vector<std::shared_ptr<SawyerChunk>> chunks;
+    for (auto park : parks)
+    {
+        OpenRCT2::FileStream fs(TestData::GetParkPath(park), OpenRCT2::FILE_MODE_OPEN);
+        SawyerChunkReader reader(&fs);
+        // The file ends with a 4 byte checksum
+        while (fs.GetPosition() + 4 < fs.GetLength())
+        {
+            chunks.push_back(reader.ReadChunk());
+        }
+    }
+    ASSERT_FALSE(chunks.empty());
+
+    auto encodedData = std::make_unique<uint8_t[]>(16 * 1024 * 1024);
+    for (const auto& chunk : chunks)
+    {
+        for (uint8_t encoding :
+             { CHUNK_ENCODING_NONE, CHUNK_ENCODING_RLE, CHUNK_ENCODING_RLECOMPRESSED, CHUNK_ENCODING_ROTATE })
+        {
+            sawyercoding_chunk_header header;
+            header.encoding = encoding;
+            header.length = static_cast<uint32_t>(chunk->GetLength());
+
+            auto data = static_cast<const uint8_t*>(chunk->GetData());
+            auto encodedLength = sawyercoding_write_chunk_buffer(encodedData.get(), data, header);
+            auto expected = reference_write_chunk(data, header);
+            ASSERT_EQ(std::vector<uint8_t>(encodedData.get(), encodedData.get() + encodedLength), expected)
+                << "encoding " << static_cast<int32_t>(encoding) << ", chunk of " << header.length << " bytes";
+        }
+    }
+
+    std::chrono::steady_clock::duration encodeTime{};
+    std::chrono::steady_clock::duration decodeTime{};
+    size_t totalLength = 0;
+    for (int32_t i = 0; i < iterations; i++)
+    {
+        for (const auto& chunk : chunks)
+        {
+            sawyercoding_chunk_header header;
+            header.encoding = static_cast<uint8_t>(chunk->GetEncoding());
+            header.length = static_cast<uint32_t>(chunk->GetLength());
+
+            auto encodeStart = std::chrono::steady_clock::now();
+            auto encodedLength = sawyercoding_write_chunk_buffer(
+                encodedData.get(), static_cast<const uint8_t*>(chunk->GetData()), header);
+            auto decodeStart = std::chrono::steady_clock::now();
+            OpenRCT2::MemoryStream ms(encodedData.get(), encodedLength);
+            SawyerChunkReader reader(&ms);
+            auto decoded = reader.ReadChunk();
+            decodeTime += std::chrono::steady_clock::now() - decodeStart;
+            encodeTime += decodeStart - encodeStart;
+
+            ASSERT_EQ(decoded->GetLength(), chunk->GetLength());
+            ASSERT_EQ(memcmp(decoded->GetData(), chunk->GetData(), chunk->GetLength()), 0);
+            totalLength += chunk->GetLength();
+        }
+    }
+
+    auto megabytes = totalLength / (1024.0 * 1024.0);
+    std::printf(
+        "%zu chunks, %.1f MiB: encode %.1f MiB/s, decode %.1f MiB/s\n", chunks.size(), megabytes,
+        megabytes / std::chrono::duration<double>(encodeTime).count(),
+        megabytes / std::chrono::duration<double>(decodeTime).count());
+}
+
 // 1024 bytes of random data
 // use `dd if=/dev/urandom bs=1024 count=1 | xxd -i` to get your own
 const uint8_t SawyerCodingTest::randomdata[] = {